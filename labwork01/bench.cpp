@@ -0,0 +1,195 @@
+#include "counter.h"
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+const size_t kMaxCorpusBlock = size_t{1} << 26;
+const char* kShapes[] = {"prose", "long_lines", "no_newlines", "utf8", "binary"};
+
+struct BenchOptions {
+    size_t size = size_t{1} << 28;
+    size_t repeat = 3;
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string shape = "all";
+};
+
+size_t ParseSize(const char* text) {
+    char* end;
+    size_t value = std::strtoull(text, &end, 10);
+    if (*end == 'K' || *end == 'k') {
+        value <<= 10;
+    } else if (*end == 'M' || *end == 'm') {
+        value <<= 20;
+    } else if (*end == 'G' || *end == 'g') {
+        value <<= 30;
+    }
+    return value;
+}
+
+void AppendWord(std::string& corpus, std::mt19937_64& random, bool is_cyrillic) {
+    size_t length = 1 + random() % 10;
+    for (size_t i = 0; i < length; i++) {
+        if (is_cyrillic) {
+            uint32_t letter = 0x430 + random() % 32;
+            corpus += static_cast<char>(0xC0 | (letter >> 6));
+            corpus += static_cast<char>(0x80 | (letter & 0x3F));
+        } else {
+            corpus += static_cast<char>('a' + random() % 26);
+        }
+    }
+}
+
+std::string GenerateCorpus(const std::string& shape, size_t size) {
+    std::mt19937_64 random(2022);
+    std::string corpus;
+    corpus.reserve(size + 64);
+    if (shape == "binary") {
+        while (corpus.size() < size) {
+            uint64_t bits = random();
+            corpus.append(reinterpret_cast<const char*>(&bits), sizeof(bits));
+        }
+        corpus.resize(size);
+        return corpus;
+    }
+
+    size_t line_length = 80;
+    if (shape == "long_lines") {
+        line_length = 1 << 16;
+    } else if (shape == "no_newlines") {
+        line_length = 0;
+    }
+    size_t line_start = 0;
+    while (corpus.size() < size) {
+        AppendWord(corpus, random, (shape == "utf8") && (random() % 4 != 0));
+        if ((line_length != 0) && (corpus.size() - line_start >= line_length)) {
+            corpus += '\n';
+            line_start = corpus.size();
+        } else {
+            corpus += ' ';
+        }
+    }
+    corpus.resize(size);
+    return corpus;
+}
+
+template<typename Pass>
+void Measure(const std::string& shape, const std::string& variant, size_t size, size_t repeat, Pass pass) {
+    double best = 0;
+    FileStats stats;
+    for (size_t r = 0; r < repeat; r++) {
+        auto start = std::chrono::steady_clock::now();
+        stats = pass();
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        if (r == 0 || elapsed.count() < best) {
+            best = elapsed.count();
+        }
+    }
+    std::cout << "{\"corpus\":\"" << shape << "\",\"variant\":\"" << variant << "\",\"bytes\":" << size
+              << ",\"seconds\":" << best << ",\"gbps\":" << (best > 0 ? size / best / 1e9 : 0)
+              << ",\"lines\":" << stats.lines << ",\"words\":" << stats.words << ",\"chars\":" << stats.chars
+              << "}\n";
+}
+
+void RunShape(const std::string& shape, const BenchOptions& options) {
+    std::string corpus = GenerateCorpus(shape, std::min(options.size, kMaxCorpusBlock));
+    size_t full_blocks = options.size / corpus.size();
+    size_t tail = options.size % corpus.size();
+
+    auto stream_with = [&](KernelKind kind) {
+        FileStats stats;
+        bool in_word = false;
+        for (size_t b = 0; b < full_blocks; b++) {
+            CountBlockWith(kind, corpus.data(), corpus.size(), stats, in_word);
+        }
+        CountBlockWith(kind, corpus.data(), tail, stats, in_word);
+        stats.words += in_word;
+        return stats;
+    };
+
+    KernelKind detected = DetectKernel();
+    for (KernelKind kind : {KernelKind::kScalar, KernelKind::kSSE2, KernelKind::kAVX2}) {
+        if (kind > detected) {
+            continue;
+        }
+        Measure(shape, KernelName(kind), options.size, options.repeat, [&]() { return stream_with(kind); });
+    }
+
+    Measure(shape, "counter", options.size, options.repeat, [&]() {
+        Counter counter;
+        for (size_t b = 0; b < full_blocks; b++) {
+            counter.Feed(corpus.data(), corpus.size());
+        }
+        counter.Feed(corpus.data(), tail);
+        return counter.Finish();
+    });
+
+    // CountBuffer runs on one corpus block at a time so that a 10G run needs
+    // no more memory than the block; the block results are merged like
+    // CountBuffer merges its chunks, joining words cut by a block boundary.
+    size_t blocks = full_blocks + (tail != 0);
+    bool is_word_joined = IsGraphic(corpus.back()) && IsGraphic(corpus.front());
+    std::string variant = "threads=" + std::to_string(options.threads);
+    Measure(shape, variant, options.size, options.repeat, [&]() {
+        FileStats stats;
+        for (size_t b = 0; b < blocks; b++) {
+            FileStats part = CountBuffer(corpus.data(), (b < full_blocks) ? corpus.size() : tail, options.threads);
+            stats.lines += part.lines - 1;
+            stats.words += part.words;
+            stats.bytes += part.bytes;
+            stats.chars += part.chars;
+        }
+        stats.words -= is_word_joined * (blocks - 1);
+        return stats;
+    });
+}
+
+bool IsKnownShape(const std::string& shape) {
+    if (shape == "all") {
+        return true;
+    }
+    for (const char* known : kShapes) {
+        if (shape == known) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--size=", 7) == 0) {
+            options.size = ParseSize(argv[i] + 7);
+        } else if (strncmp(argv[i], "--shape=", 8) == 0) {
+            options.shape = argv[i] + 8;
+        } else if (strncmp(argv[i], "--repeat=", 9) == 0) {
+            options.repeat = std::max<size_t>(1, std::strtoull(argv[i] + 9, nullptr, 10));
+        } else if (strncmp(argv[i], "--threads=", 10) == 0) {
+            options.threads = std::max<size_t>(1, std::strtoull(argv[i] + 10, nullptr, 10));
+        } else {
+            std::cout << "Options can be only --size=N[K|M|G], --shape=NAME|all, --repeat=N, --threads=N.\n";
+            return 1;
+        }
+    }
+    if (options.size == 0) {
+        std::cout << "Corpus size must be positive.\n";
+        return 1;
+    }
+    if (!IsKnownShape(options.shape)) {
+        std::cout << "Unknown shape " << options.shape
+                  << ". Shapes can be only prose, long_lines, no_newlines, utf8, binary or all.\n";
+        return 1;
+    }
+
+    for (const char* shape : kShapes) {
+        if (options.shape == "all" || options.shape == shape) {
+            RunShape(shape, options);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include "counter.h"
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+const size_t kMinChunkSize = 1 << 23;
+
+void Counter::Feed(const char* data, size_t size) {
+    CountBlock(data, size, stats_, in_word_);
+}
+
+void Counter::Feed(std::string_view data) {
+    Feed(data.data(), data.size());
+}
+
+void Counter::SeedPrevious(char previous) {
+    in_word_ = IsGraphic(previous);
+}
+
+const FileStats& Counter::Stats() const {
+    return stats_;
+}
+
+FileStats Counter::Finish() {
+    FileStats stats = stats_;
+    stats.words += in_word_;
+    Reset();
+    return stats;
+}
+
+void Counter::Reset() {
+    stats_ = FileStats();
+    in_word_ = false;
+}
+
+FileStats CountBuffer(const char* data, size_t size, size_t threads) {
+    size_t chunks = std::max<size_t>(1, std::min(threads, size / kMinChunkSize));
+    if (chunks == 1) {
+        Counter counter;
+        counter.Feed(data, size);
+        return counter.Finish();
+    }
+
+    std::vector<FileStats> partial(chunks);
+    std::vector<std::thread> workers;
+    for (size_t k = 0; k < chunks; k++) {
+        size_t begin = size / chunks * k;
+        size_t end = (k + 1 == chunks) ? size : size / chunks * (k + 1);
+        bool is_last = (k + 1 == chunks);
+        workers.emplace_back([&partial, data, begin, end, k, is_last]() {
+            Counter counter;
+            if (begin > 0) {
+                counter.SeedPrevious(data[begin - 1]);
+            }
+            counter.Feed(data + begin, end - begin);
+            partial[k] = is_last ? counter.Finish() : counter.Stats();
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    FileStats stats;
+    for (const FileStats& part : partial) {
+        stats.lines += part.lines - 1;
+        stats.words += part.words;
+        stats.bytes += part.bytes;
+        stats.chars += part.chars;
+    }
+    return stats;
+}
+
+FileStats CountStats(InputReader& reader, size_t threads) {
+    if (reader.IsMapped()) {
+        return CountBuffer(reader.MappedData(), reader.MappedSize(), threads);
+    }
+    Counter counter;
+    const char* data;
+    size_t size;
+    while (reader.NextBlock(data, size)) {
+        counter.Feed(data, size);
+    }
+    return counter.Finish();
+}
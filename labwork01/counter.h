@@ -0,0 +1,27 @@
+#pragma once
+#include "kernels.h"
+#include "reader.h"
+#include <string_view>
+
+class Counter {
+public:
+    void Feed(const char* data, size_t size);
+
+    void Feed(std::string_view data);
+
+    void SeedPrevious(char previous);
+
+    const FileStats& Stats() const;
+
+    FileStats Finish();
+
+    void Reset();
+
+private:
+    FileStats stats_;
+    bool in_word_ = false;
+};
+
+FileStats CountBuffer(const char* data, size_t size, size_t threads = 1);
+
+FileStats CountStats(InputReader& reader, size_t threads = 1);
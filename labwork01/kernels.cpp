@@ -0,0 +1,168 @@
+#include "kernels.h"
+#include <cctype>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define WC_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+const uint8_t kSpace = 1;
+const uint8_t kGraph = 2;
+
+struct CharClasses {
+    uint8_t table[256] = {};
+
+    CharClasses() {
+        for (size_t c = 0; c < 256; c++) {
+            if (std::isspace(static_cast<int>(c))) {
+                table[c] |= kSpace;
+            }
+            if (std::isgraph(static_cast<int>(c))) {
+                table[c] |= kGraph;
+            }
+        }
+    }
+};
+
+const CharClasses kCharClasses;
+
+static void CountScalar(const char* data, size_t size, FileStats& stats, bool& in_word) {
+    for (size_t i = 0; i < size; i++) {
+        uint8_t current = static_cast<uint8_t>(data[i]);
+        uint8_t classes = kCharClasses.table[current];
+        stats.lines += (current == '\n');
+        stats.chars += ((current & 0xC0) != 0x80);
+        stats.words += (in_word && (classes & kSpace));
+        in_word = (classes & kGraph) != 0;
+    }
+}
+
+#ifdef WC_X86_KERNELS
+
+// Masks hold one bit per byte of a 64-byte stripe. A word ends on a whitespace
+// byte whose predecessor is graphic; the predecessor of bit 0 is carried in.
+// Every UTF-8 code point has exactly one byte that is not 10xxxxxx.
+static inline void AccumulateMasks(uint64_t newline, uint64_t space, uint64_t graph, uint64_t lead,
+                                   FileStats& stats, uint64_t& carry) {
+    stats.lines += __builtin_popcountll(newline);
+    stats.chars += __builtin_popcountll(lead);
+    stats.words += __builtin_popcountll(space & ((graph << 1) | carry));
+    carry = graph >> 63;
+}
+
+__attribute__((target("sse2")))
+static inline void ClassifySSE2(__m128i bytes, uint64_t& newline, uint64_t& space, uint64_t& graph,
+                                uint64_t& lead, int shift) {
+    __m128i above_space = _mm_cmpgt_epi8(bytes, _mm_set1_epi8(0x20));
+    __m128i below_del = _mm_cmpgt_epi8(_mm_set1_epi8(0x7F), bytes);
+    __m128i is_blank = _mm_cmpeq_epi8(bytes, _mm_set1_epi8(' '));
+    __m128i is_control_space = _mm_and_si128(_mm_cmpgt_epi8(bytes, _mm_set1_epi8(0x08)),
+                                             _mm_cmpgt_epi8(_mm_set1_epi8(0x0E), bytes));
+    __m128i is_graph = _mm_and_si128(above_space, below_del);
+
+    newline |= uint64_t(uint16_t(_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('\n'))))) << shift;
+    space |= uint64_t(uint16_t(_mm_movemask_epi8(_mm_or_si128(is_blank, is_control_space)))) << shift;
+    graph |= uint64_t(uint16_t(_mm_movemask_epi8(is_graph))) << shift;
+    lead |= uint64_t(uint16_t(_mm_movemask_epi8(_mm_cmpgt_epi8(bytes, _mm_set1_epi8(-65))))) << shift;
+}
+
+__attribute__((target("sse2")))
+static void CountSSE2(const char* data, size_t size, FileStats& stats, bool& in_word) {
+    uint64_t carry = in_word;
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        uint64_t newline = 0, space = 0, graph = 0, lead = 0;
+        for (int part = 0; part < 4; part++) {
+            __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + 16 * part));
+            ClassifySSE2(bytes, newline, space, graph, lead, 16 * part);
+        }
+        AccumulateMasks(newline, space, graph, lead, stats, carry);
+    }
+    in_word = carry != 0;
+    CountScalar(data + i, size - i, stats, in_word);
+}
+
+__attribute__((target("avx2,popcnt")))
+static inline void ClassifyAVX2(__m256i bytes, uint64_t& newline, uint64_t& space, uint64_t& graph,
+                                uint64_t& lead, int shift) {
+    __m256i above_space = _mm256_cmpgt_epi8(bytes, _mm256_set1_epi8(0x20));
+    __m256i below_del = _mm256_cmpgt_epi8(_mm256_set1_epi8(0x7F), bytes);
+    __m256i is_blank = _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(' '));
+    __m256i is_control_space = _mm256_and_si256(_mm256_cmpgt_epi8(bytes, _mm256_set1_epi8(0x08)),
+                                                _mm256_cmpgt_epi8(_mm256_set1_epi8(0x0E), bytes));
+    __m256i is_graph = _mm256_and_si256(above_space, below_del);
+
+    newline |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\n'))))) << shift;
+    space |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_or_si256(is_blank, is_control_space)))) << shift;
+    graph |= uint64_t(uint32_t(_mm256_movemask_epi8(is_graph))) << shift;
+    lead |= uint64_t(uint32_t(_mm256_movemask_epi8(_mm256_cmpgt_epi8(bytes, _mm256_set1_epi8(-65))))) << shift;
+}
+
+__attribute__((target("avx2,popcnt")))
+static void CountAVX2(const char* data, size_t size, FileStats& stats, bool& in_word) {
+    uint64_t carry = in_word;
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        uint64_t newline = 0, space = 0, graph = 0, lead = 0;
+        __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i));
+        __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + 32));
+        ClassifyAVX2(low, newline, space, graph, lead, 0);
+        ClassifyAVX2(high, newline, space, graph, lead, 32);
+        AccumulateMasks(newline, space, graph, lead, stats, carry);
+    }
+    in_word = carry != 0;
+    CountScalar(data + i, size - i, stats, in_word);
+}
+
+#endif
+
+bool IsGraphic(char c) {
+    return (kCharClasses.table[static_cast<uint8_t>(c)] & kGraph) != 0;
+}
+
+KernelKind DetectKernel() {
+#ifdef WC_X86_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) {
+        return KernelKind::kAVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return KernelKind::kSSE2;
+    }
+#endif
+    return KernelKind::kScalar;
+}
+
+const char* KernelName(KernelKind kind) {
+    switch (kind) {
+        case KernelKind::kAVX2:
+            return "avx2";
+        case KernelKind::kSSE2:
+            return "sse2";
+        default:
+            return "scalar";
+    }
+}
+
+void CountBlockWith(KernelKind kind, const char* data, size_t size, FileStats& stats, bool& in_word) {
+    switch (kind) {
+#ifdef WC_X86_KERNELS
+        case KernelKind::kAVX2:
+            CountAVX2(data, size, stats, in_word);
+            break;
+        case KernelKind::kSSE2:
+            CountSSE2(data, size, stats, in_word);
+            break;
+#endif
+        default:
+            CountScalar(data, size, stats, in_word);
+            break;
+    }
+    stats.bytes += size;
+}
+
+const KernelKind kSelectedKernel = DetectKernel();
+
+void CountBlock(const char* data, size_t size, FileStats& stats, bool& in_word) {
+    CountBlockWith(kSelectedKernel, data, size, stats, in_word);
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+struct FileStats {
+    size_t lines = 1;
+    size_t words = 0;
+    size_t bytes = 0;
+    size_t chars = 0;
+};
+
+enum class KernelKind {
+    kScalar,
+    kSSE2,
+    kAVX2
+};
+
+KernelKind DetectKernel();
+
+const char* KernelName(KernelKind kind);
+
+bool IsGraphic(char c);
+
+void CountBlock(const char* data, size_t size, FileStats& stats, bool& in_word);
+
+void CountBlockWith(KernelKind kind, const char* data, size_t size, FileStats& stats, bool& in_word);
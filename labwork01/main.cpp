@@ -1,11 +1,18 @@
+#include "counter.h"
 #include <iostream>
-#include <fstream>
 #include <vector>
 #include <algorithm>
+#include <cstring>
+#include <cstdlib>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
 
 class ConsoleOptions {
 public:
     bool lines_ = false, words_ = false, bytes_ = false, chars_ = false;
+    size_t threads_ = std::max(1u, std::thread::hardware_concurrency());
 
     void AllOptionsToTrue() {
         lines_ = true;
@@ -23,68 +30,89 @@ public:
     }
 };
 
-size_t BytesCount(std::ifstream& file) {
-    char current;
-    size_t bytes = 0;
-    while (file.get(current)) {
-        bytes++;
-    }
-    return bytes;
-}
+struct FileResult {
+    bool is_open = false;
+    FileStats stats;
+};
 
-size_t WordsCount(std::ifstream& file) {
-    file.clear();
-    file.seekg(0, std::ios::beg);
-    char previous = NULL, current = NULL;
-    size_t words = 0;
-    file.get(previous);
-    while (file.get(current)) {
-        if (std::isprint(previous) && (previous != ' ') && std::isspace(current)) {
-            words++;
+class FileCountPool {
+public:
+    FileCountPool(const std::vector<std::string>& filenames, size_t threads)
+            : filenames_(filenames), results_(filenames.size()), is_ready_(filenames.size(), false) {
+        size_t workers = std::max<size_t>(1, std::min(threads, filenames.size()));
+        file_threads_ = (workers == 1) ? threads : 1;
+        for (size_t i = 0; i < workers; i++) {
+            workers_.emplace_back(&FileCountPool::Work, this);
         }
-        previous = current;
     }
-    if (current == NULL) {
-        if ((previous != NULL) && (previous != ' ') && (std::isprint(previous))) {
-            words++;
+
+    ~FileCountPool() {
+        stopped_ = true;
+        for (std::thread& worker : workers_) {
+            worker.join();
         }
-    } else if ((current != ' ') && std::isprint(current)) {
-        words++;
     }
-    return words;
-}
 
-size_t LinesCount(std::ifstream& file) {
-    file.clear();
-    file.seekg(0, std::ios::beg);
-    char current;
-    size_t lines = 1;
-    while (file.get(current)) {
-        if (current == '\n') {
-            lines++;
-        }
+    const FileResult& Wait(size_t index) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ready_.wait(lock, [this, index]() { return is_ready_[index]; });
+        return results_[index];
     }
-    return lines;
-}
 
-size_t CharsCount(std::ifstream& file) {
-    file.clear();
-    file.seekg(0, std::ios::beg);
-    char current;
-    size_t chars = 0;
-    while (file.get(current)) {
-        if (std::isprint(current)) {
-            chars++;
+private:
+    void Work() {
+        size_t index;
+        while (!stopped_ && (index = next_++) < filenames_.size()) {
+            FileResult result;
+            InputReader reader(filenames_[index]);
+            result.is_open = reader.IsOpen();
+            if (result.is_open) {
+                result.stats = CountStats(reader, file_threads_);
+            }
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                results_[index] = result;
+                is_ready_[index] = true;
+            }
+            ready_.notify_all();
         }
     }
-    return chars;
+
+    const std::vector<std::string>& filenames_;
+    std::vector<FileResult> results_;
+    std::vector<bool> is_ready_;
+    size_t file_threads_ = 1;
+
+    std::atomic<size_t> next_{0};
+    std::atomic<bool> stopped_{false};
+    std::mutex mutex_;
+    std::condition_variable ready_;
+    std::vector<std::thread> workers_;
+};
+
+void PrintStats(const FileStats& stats, const ConsoleOptions& options, const std::string& name) {
+    if (options.lines_) {
+        std::cout << stats.lines << ' ';
+    }
+    if (options.words_) {
+        std::cout << stats.words << ' ';
+    }
+    if (options.bytes_) {
+        std::cout << stats.bytes << ' ';
+    }
+    if (options.chars_) {
+        std::cout << stats.chars << ' ';
+    }
+    std::cout << name << '\n';
 }
 
 int main(int argc, char *argv[]) {
     ConsoleOptions options;
     std::vector<std::string> filenames;
     for (size_t i = 1; i < argc; i++) {
-        if (argv[i][0] == '-') {
+        if (argv[i] == kStdinName) {
+            filenames.push_back(argv[i]);
+        } else if (argv[i][0] == '-') {
             if ((strlen(argv[i]) > 1) && (argv[i][1] == '-')) {
                 if (strcmp(argv[i], "--lines") == 0) {
                     options.lines_ = true;
@@ -94,8 +122,10 @@ int main(int argc, char *argv[]) {
                     options.bytes_ = true;
                 } else if (strcmp(argv[i], "--chars") == 0) {
                     options.chars_ = true;
+                } else if ((strncmp(argv[i], "--threads=", 10) == 0) && (std::strtoul(argv[i] + 10, nullptr, 10) > 0)) {
+                    options.threads_ = std::strtoul(argv[i] + 10, nullptr, 10);
                 } else {
-                    std::cout << "Options can be only --lines, --words, --bytes, --chars or -l, -c, -w, -m.\n";
+                    std::cout << "Options can be only --lines, --words, --bytes, --chars, --threads=N or -l, -c, -w, -m.\n";
                     return 0;
                 }
             } else {
@@ -109,7 +139,7 @@ int main(int argc, char *argv[]) {
                     } else if (argv[i][j] == 'm') {
                         options.chars_ = true;
                     } else {
-                        std::cout << "Options can be only --lines, --words, --bytes, --chars or -l, -c, -w, -m.\n";
+                        std::cout << "Options can be only --lines, --words, --bytes, --chars, --threads=N or -l, -c, -w, -m.\n";
                         return 0;
                     }
                 }
@@ -118,33 +148,30 @@ int main(int argc, char *argv[]) {
             filenames.push_back(argv[i]);
         }
     }
+    if (filenames.empty()) {
+        filenames.push_back(kStdinName);
+    }
     if (options.IsAllOptionsFalse()) {
         options.AllOptionsToTrue();
     }
 
-    std::ifstream file, file_binary;
-    std::string filename;
+    FileCountPool pool(filenames, options.threads_);
+    FileStats total;
+    total.lines = 0;
     for (size_t i = 0; i < filenames.size(); i++) {
-        filename = filenames[i];
-        file.open(filename);
-        file_binary.open(filename, std::ios::binary);
-        if (!file.is_open()) {
+        const FileResult& result = pool.Wait(i);
+        if (!result.is_open) {
             std::cout << "Invalid name of file.\n";
             return 0;
         }
-        if (options.lines_) {
-            std::cout << LinesCount(file) << ' ';
-        }
-        if (options.words_) {
-            std::cout << WordsCount(file) << ' ';
-        }
-        if (options.bytes_) {
-            std::cout << BytesCount(file_binary) << ' ';
-        }
-        if (options.chars_) {
-            std::cout << CharsCount(file) << ' ';
-        }
-        std::cout << filename << std::endl;
+        PrintStats(result.stats, options, filenames[i]);
+        total.lines += result.stats.lines;
+        total.words += result.stats.words;
+        total.bytes += result.stats.bytes;
+        total.chars += result.stats.chars;
+    }
+    if (filenames.size() > 1) {
+        PrintStats(total, options, "total");
     }
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,111 @@
+#include "reader.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#define WC_HAS_MMAP 1
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+const size_t kReadBlockSize = 1 << 18;
+
+#ifdef WC_HAS_MMAP
+
+InputReader::InputReader(const std::string& filename) {
+    is_stdin_ = (filename == kStdinName);
+    descriptor_ = is_stdin_ ? STDIN_FILENO : open(filename.c_str(), O_RDONLY);
+    if (descriptor_ < 0) {
+        return;
+    }
+    is_open_ = true;
+
+    struct stat info{};
+    bool is_mappable = !is_stdin_ || (lseek(descriptor_, 0, SEEK_CUR) == 0);
+    if (is_mappable && (fstat(descriptor_, &info) == 0) && S_ISREG(info.st_mode) && (info.st_size > 0)) {
+        void* address = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, descriptor_, 0);
+        if (address != MAP_FAILED) {
+            mapped_ = static_cast<char*>(address);
+            mapped_size_ = info.st_size;
+            madvise(mapped_, mapped_size_, MADV_SEQUENTIAL);
+            madvise(mapped_, mapped_size_, MADV_WILLNEED);
+            return;
+        }
+    }
+    buffer_.resize(kReadBlockSize);
+}
+
+InputReader::~InputReader() {
+    if (mapped_ != nullptr) {
+        munmap(mapped_, mapped_size_);
+    }
+    if ((descriptor_ >= 0) && !is_stdin_) {
+        close(descriptor_);
+    }
+}
+
+bool InputReader::NextBlock(const char*& data, size_t& size) {
+    if (mapped_ != nullptr) {
+        if (mapped_consumed_) {
+            return false;
+        }
+        mapped_consumed_ = true;
+        data = mapped_;
+        size = mapped_size_;
+        return true;
+    }
+    ssize_t count;
+    do {
+        count = read(descriptor_, buffer_.data(), buffer_.size());
+    } while (count < 0 && errno == EINTR);
+    if (count <= 0) {
+        return false;
+    }
+    data = buffer_.data();
+    size = count;
+    return true;
+}
+
+#else
+
+InputReader::InputReader(const std::string& filename) {
+    is_stdin_ = (filename == kStdinName);
+    if (is_stdin_) {
+        input_ = &std::cin;
+    } else {
+        stream_.open(filename, std::ios::binary);
+        input_ = &stream_;
+    }
+    is_open_ = is_stdin_ || stream_.is_open();
+    buffer_.resize(kReadBlockSize);
+}
+
+InputReader::~InputReader() = default;
+
+bool InputReader::NextBlock(const char*& data, size_t& size) {
+    if (!input_->read(buffer_.data(), buffer_.size()) && input_->gcount() == 0) {
+        return false;
+    }
+    data = buffer_.data();
+    size = input_->gcount();
+    return true;
+}
+
+#endif
+
+bool InputReader::IsOpen() const {
+    return is_open_;
+}
+
+bool InputReader::IsMapped() const {
+    return mapped_ != nullptr;
+}
+
+const char* InputReader::MappedData() const {
+    return mapped_;
+}
+
+size_t InputReader::MappedSize() const {
+    return mapped_size_;
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+const std::string kStdinName = "-";
+
+class InputReader {
+public:
+    explicit InputReader(const std::string& filename);
+
+    ~InputReader();
+
+    InputReader(const InputReader&) = delete;
+
+    InputReader& operator=(const InputReader&) = delete;
+
+    bool IsOpen() const;
+
+    bool IsMapped() const;
+
+    const char* MappedData() const;
+
+    size_t MappedSize() const;
+
+    bool NextBlock(const char*& data, size_t& size);
+
+private:
+    int descriptor_ = -1;
+    bool is_open_ = false;
+    bool is_stdin_ = false;
+
+    char* mapped_ = nullptr;
+    size_t mapped_size_ = 0;
+    bool mapped_consumed_ = false;
+
+    std::ifstream stream_;
+    std::istream* input_ = nullptr;
+    std::vector<char> buffer_;
+};
@@ -0,0 +1,156 @@
+#include "counter.h"
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+
+static void ExpectSameStats(const FileStats& actual, const FileStats& expected) {
+    EXPECT_EQ(actual.lines, expected.lines);
+    EXPECT_EQ(actual.words, expected.words);
+    EXPECT_EQ(actual.bytes, expected.bytes);
+    EXPECT_EQ(actual.chars, expected.chars);
+}
+
+// Short words of random length, so chunk boundaries fall inside words, right
+// after them and between separators.
+static std::string RandomText(size_t size, uint64_t seed) {
+    std::mt19937_64 random(seed);
+    const char separators[] = {' ', ' ', ' ', '\n', '\t', '\r'};
+    std::string text;
+    text.reserve(size);
+    while (text.size() < size) {
+        size_t length = random() % 5;
+        for (size_t i = 0; i < length; i++) {
+            text += static_cast<char>('a' + random() % 26);
+        }
+        text += separators[random() % sizeof(separators)];
+    }
+    text.resize(size);
+    return text;
+}
+
+TEST(CountBufferTests, ThreadsMatchOneThreadTest) {
+    std::string text = RandomText((size_t{1} << 25) + 12345, 2022);
+
+    // Each offset moves the chunk boundaries onto other bytes.
+    for (size_t offset = 0; offset < 8; offset++) {
+        const char* data = text.data() + offset;
+        size_t size = text.size() - offset;
+        FileStats expected = CountBuffer(data, size, 1);
+        for (size_t threads : {2, 4}) {
+            SCOPED_TRACE(testing::Message() << "offset " << offset << ", threads " << threads);
+            ExpectSameStats(CountBuffer(data, size, threads), expected);
+        }
+    }
+}
+
+TEST(CountBufferTests, WordAcrossChunksTest) {
+    std::string text((size_t{1} << 25) + 7, 'x');
+    text[100] = ' ';
+
+    FileStats stats = CountBuffer(text.data(), text.size(), 4);
+    EXPECT_EQ(stats.words, 2);
+    EXPECT_EQ(stats.lines, 1);
+    EXPECT_EQ(stats.bytes, text.size());
+
+    text.back() = '\n';
+    text[text.size() / 2 - 1] = ' ';
+    stats = CountBuffer(text.data(), text.size(), 4);
+    EXPECT_EQ(stats.words, 3);
+    EXPECT_EQ(stats.lines, 2);
+}
+
+TEST(KernelTests, MatchScalarTest) {
+    std::mt19937_64 random(2022);
+    std::string bytes(1000, '\0');
+    for (char& byte : bytes) {
+        byte = static_cast<char>(random());
+    }
+    std::string text = RandomText(1000, 7);
+
+    for (KernelKind kind : {KernelKind::kSSE2, KernelKind::kAVX2}) {
+        if (kind > DetectKernel()) {
+            continue;
+        }
+        for (const std::string* input : {&bytes, &text}) {
+            for (size_t size = 0; size <= 300; size++) {
+                for (bool is_in_word : {false, true}) {
+                    SCOPED_TRACE(testing::Message() << KernelName(kind) << ", size " << size << ", in word " << is_in_word);
+                    const char* data = input->data() + size % 13;
+                    FileStats expected;
+                    bool expected_in_word = is_in_word;
+                    CountBlockWith(KernelKind::kScalar, data, size, expected, expected_in_word);
+                    FileStats actual;
+                    bool actual_in_word = is_in_word;
+                    CountBlockWith(kind, data, size, actual, actual_in_word);
+                    ExpectSameStats(actual, expected);
+                    EXPECT_EQ(actual_in_word, expected_in_word);
+                }
+            }
+        }
+    }
+}
+
+// --chars counts code points: two bytes for each Cyrillic letter, three for
+// the dash and the euro sign, four for the clef.
+TEST(KernelTests, CyrillicCharsTest) {
+    std::string line = "Привет, мир! Ёж — ёж, €𝄞.\n";
+    std::string text;
+    for (int i = 0; i < 10; i++) {
+        text += line;
+    }
+
+    for (KernelKind kind : {KernelKind::kScalar, KernelKind::kSSE2, KernelKind::kAVX2}) {
+        if (kind > DetectKernel()) {
+            continue;
+        }
+        SCOPED_TRACE(KernelName(kind));
+        FileStats stats;
+        bool in_word = false;
+        CountBlockWith(kind, text.data(), text.size(), stats, in_word);
+        EXPECT_EQ(stats.chars, 260);
+        EXPECT_EQ(stats.bytes, 460);
+        EXPECT_EQ(stats.lines, 11);
+    }
+    EXPECT_EQ(CountBuffer(text.data(), text.size()).chars, 260);
+}
+
+TEST(CounterTests, FeedSplitAtEveryOffsetTest) {
+    std::string text = "  one two\tthree\nчетыре пять\n\nsix,seven \r\n eight";
+    FileStats expected = CountBuffer(text.data(), text.size());
+    EXPECT_EQ(expected.lines, 5);
+
+    Counter counter;
+    for (size_t first = 0; first <= text.size(); first++) {
+        for (size_t second = first; second <= text.size(); second++) {
+            SCOPED_TRACE(testing::Message() << "split at " << first << " and " << second);
+            std::string_view view = text;
+            counter.Feed(view.substr(0, first));
+            counter.Feed(view.substr(first, second - first));
+            counter.Feed(view.substr(second));
+            EXPECT_EQ(counter.Stats().bytes, text.size());
+            ExpectSameStats(counter.Finish(), expected);
+        }
+    }
+}
+
+TEST(CounterTests, SeedPreviousTest) {
+    std::string text = "one two";
+    Counter counter;
+
+    counter.Feed(text.data() + 2, text.size() - 2);
+    EXPECT_EQ(counter.Finish().words, 2);
+
+    counter.SeedPrevious(text[1]);
+    counter.Feed(text.data() + 2, text.size() - 2);
+    FileStats stats = counter.Finish();
+    EXPECT_EQ(stats.words, 2);
+    EXPECT_EQ(stats.bytes, text.size() - 2);
+
+    counter.SeedPrevious(text[2]);
+    counter.Feed(text.data() + 3, text.size() - 3);
+    EXPECT_EQ(counter.Finish().words, 2);
+
+    counter.Feed(text);
+    counter.Reset();
+    EXPECT_EQ(counter.Finish().words, 0);
+}
@@ -0,0 +1,266 @@
+#include <lib/number.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Operands are cycled through a small pool so that the timed loop is not a
+// single repeated value the branch predictor can learn.
+static const size_t POOL_SIZE = 64;
+
+struct bench_options {
+    size_t repeat = 5;
+    double min_seconds = 0.02;
+    std::string baseline;
+    double threshold = 0.10;
+    std::map<std::string, double> op_thresholds;
+};
+
+struct bench_key {
+    std::string type;
+    size_t limbs;
+    std::string op;
+
+    bool operator<(const bench_key& other) const {
+        return std::tie(type, limbs, op) < std::tie(other.type, other.limbs, other.op);
+    }
+};
+
+// Swallows stream output and only counts it, so operator<< is timed without
+// the cost of growing a string.
+class counting_buffer : public std::streambuf {
+public:
+    size_t count = 0;
+
+protected:
+    int_type overflow(int_type ch) override {
+        count++;
+        return ch;
+    }
+
+    std::streamsize xsputn(const char*, std::streamsize size) override {
+        count += size;
+        return size;
+    }
+};
+
+static uint64_t sink = 0;
+
+// Folds both ends of the result into the sink so no part of the operation is dead code.
+template<typename T>
+uint64_t checksum(const T& value) {
+    return value.digits[0] ^ value.digits[T::MAX_SIZE - 1] ^ value.size();
+}
+
+// A value with exactly limbs limbs that still fits into the declared bit width.
+template<typename T>
+T random_value(std::mt19937_64& random, size_t limbs) {
+    T value;
+    for (size_t i = 0; i < limbs; i++) {
+        value.digits[i] = random();
+    }
+    size_t top_bit = std::min<size_t>(T::LIMB_BITS, T::BITS - (limbs - 1) * T::LIMB_BITS) - 1;
+    value.digits[limbs - 1] &= (top_bit + 1 == T::LIMB_BITS) ? UINT64_MAX : (uint64_t{1} << (top_bit + 1)) - 1;
+    value.digits[limbs - 1] |= uint64_t{1} << top_bit;
+    value.resize(limbs);
+    return value;
+}
+
+// Best-of-repeat nanoseconds per call; the round count doubles until one
+// measurement lasts at least min_seconds.
+template<typename Operation>
+double measure(const bench_options& options, Operation operation) {
+    size_t rounds = 1;
+    double best = 0;
+    for (size_t r = 0; r < options.repeat; r++) {
+        while (true) {
+            auto start = std::chrono::steady_clock::now();
+            for (size_t round = 0; round < rounds; round++) {
+                for (size_t i = 0; i < POOL_SIZE; i++) {
+                    sink += operation(i);
+                }
+            }
+            std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+            if (elapsed.count() < options.min_seconds) {
+                rounds *= 2;
+                continue;
+            }
+            double ns = elapsed.count() * 1e9 / (rounds * POOL_SIZE);
+            if (r == 0 || ns < best) {
+                best = ns;
+            }
+            break;
+        }
+    }
+    return best;
+}
+
+std::string json_field(const std::string& line, const std::string& name) {
+    std::string key = "\"" + name + "\":";
+    size_t start = line.find(key);
+    if (start == std::string::npos) {
+        return "";
+    }
+    start += key.size();
+    size_t end = line.find_first_of(",}", start);
+    std::string value = line.substr(start, end - start);
+    if (value.size() >= 2 && value.front() == '"') {
+        value = value.substr(1, value.size() - 2);
+    }
+    return value;
+}
+
+std::map<bench_key, double> load_baseline(std::istream& file) {
+    std::map<bench_key, double> baseline;
+    std::string line;
+    while (std::getline(file, line)) {
+        std::string ns = json_field(line, "ns");
+        if (ns.empty()) {
+            continue;
+        }
+        bench_key key{json_field(line, "type"), std::strtoull(json_field(line, "limbs").c_str(), nullptr, 10),
+                      json_field(line, "op")};
+        baseline[key] = std::strtod(ns.c_str(), nullptr);
+    }
+    return baseline;
+}
+
+class bench_report {
+public:
+    bench_report(const bench_options& options, std::map<bench_key, double> baseline)
+        : options_(options),
+          baseline_(std::move(baseline)) {
+    }
+
+    void add(const bench_key& key, double ns) {
+        std::cout << "{\"type\":\"" << key.type << "\",\"limbs\":" << key.limbs << ",\"op\":\"" << key.op
+                  << "\",\"ns\":" << ns;
+        auto found = baseline_.find(key);
+        if (found != baseline_.end() && found->second > 0) {
+            compared_++;
+            double change = ns / found->second - 1;
+            auto op_threshold = options_.op_thresholds.find(key.op);
+            double threshold = (op_threshold != options_.op_thresholds.end()) ? op_threshold->second
+                                                                              : options_.threshold;
+            bool is_regression = change > threshold;
+            std::cout << ",\"baseline_ns\":" << found->second << ",\"change\":" << change
+                      << ",\"threshold\":" << threshold << ",\"regression\":" << (is_regression ? "true" : "false");
+            if (is_regression) {
+                regressions_.push_back(key.type + "/" + std::to_string(key.limbs) + "/" + key.op);
+            }
+        }
+        std::cout << "}\n";
+    }
+
+    int finish() const {
+        for (const std::string& name : regressions_) {
+            std::cerr << "regression: " << name << '\n';
+        }
+        if (!baseline_.empty() && compared_ == 0) {
+            std::cerr << "no benchmark matches a row of " << options_.baseline << '\n';
+            return 1;
+        }
+        return regressions_.empty() ? 0 : 1;
+    }
+
+private:
+    const bench_options& options_;
+    std::map<bench_key, double> baseline_;
+    std::vector<std::string> regressions_;
+    size_t compared_ = 0;
+};
+
+template<typename T>
+void run_width(const char* type, size_t limbs, const bench_options& options, bench_report& report) {
+    std::mt19937_64 random(2022 + limbs);
+    std::vector<T> lhs;
+    std::vector<T> rhs;
+    std::vector<T> divisors;
+    std::vector<T> near_equal;
+    std::vector<std::string> decimal;
+    for (size_t i = 0; i < POOL_SIZE; i++) {
+        lhs.push_back(random_value<T>(random, limbs));
+        rhs.push_back(random_value<T>(random, limbs));
+        // "sub" times the non-wrapping case.
+        if (lhs.back() < rhs.back()) {
+            std::swap(lhs.back(), rhs.back());
+        }
+        divisors.push_back(random_value<T>(random, std::max<size_t>(1, limbs / 2)));
+        near_equal.push_back(lhs.back());
+        near_equal.back().digits[0] ^= 1;
+        char buffer[uint_detail::max_decimal_digits<T>()];
+        decimal.emplace_back(buffer, to_chars(buffer, buffer + sizeof(buffer), lhs.back()).ptr);
+    }
+
+    counting_buffer counter;
+    std::ostream null_stream(&counter);
+
+    report.add({type, limbs, "add"}, measure(options, [&](size_t i) { return checksum(lhs[i] + rhs[i]); }));
+    report.add({type, limbs, "sub"}, measure(options, [&](size_t i) { return checksum(lhs[i] - rhs[i]); }));
+    report.add({type, limbs, "mul"}, measure(options, [&](size_t i) { return checksum(lhs[i] * rhs[i]); }));
+    report.add({type, limbs, "div"}, measure(options, [&](size_t i) { return checksum(lhs[i] / divisors[i]); }));
+    report.add({type, limbs, "cmp"}, measure(options, [&](size_t i) { return uint64_t{lhs[i] < near_equal[i]}; }));
+    report.add({type, limbs, "from_string"},
+               measure(options, [&](size_t i) { return checksum(from_string<T>(decimal[i].c_str())); }));
+    report.add({type, limbs, "operator<<"}, measure(options, [&](size_t i) {
+        null_stream << lhs[i];
+        return uint64_t{counter.count};
+    }));
+}
+
+int main(int argc, char* argv[]) {
+    bench_options options;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--repeat=", 9) == 0) {
+            options.repeat = std::max<size_t>(1, std::strtoull(argv[i] + 9, nullptr, 10));
+        } else if (strncmp(argv[i], "--min-time=", 11) == 0) {
+            options.min_seconds = std::strtod(argv[i] + 11, nullptr) / 1000;
+        } else if (strncmp(argv[i], "--baseline=", 11) == 0) {
+            options.baseline = argv[i] + 11;
+        } else if (strncmp(argv[i], "--threshold=", 12) == 0) {
+            const char* value = argv[i] + 12;
+            const char* colon = std::strchr(value, ':');
+            if (colon == nullptr) {
+                options.threshold = std::strtod(value, nullptr);
+            } else {
+                options.op_thresholds[std::string(value, colon)] = std::strtod(colon + 1, nullptr);
+            }
+        } else {
+            std::cerr << "Usage: number_bench [--repeat=N] [--min-time=MS] [--baseline=FILE] "
+                         "[--threshold=FRACTION] [--threshold=OP:FRACTION]\n";
+            return 2;
+        }
+    }
+
+    // A missing or empty baseline would compare nothing and pass a regression gate.
+    std::map<bench_key, double> baseline;
+    if (!options.baseline.empty()) {
+        std::ifstream file(options.baseline);
+        if (!file) {
+            std::cerr << "cannot open baseline " << options.baseline << '\n';
+            return 2;
+        }
+        baseline = load_baseline(file);
+        if (baseline.empty()) {
+            std::cerr << "baseline " << options.baseline << " has no benchmark rows\n";
+            return 2;
+        }
+    }
+
+    bench_report report(options, std::move(baseline));
+    for (size_t limbs : {1, 8, 16, 32}) {
+        run_width<uint2022_t>("uint2022_t", limbs, options, report);
+    }
+    for (size_t limbs : {32, 64}) {
+        run_width<uint4096_t>("uint4096_t", limbs, options, report);
+    }
+    return report.finish();
+}
@@ -0,0 +1,169 @@
+#include "batch.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define NUMBER_X86_KERNELS 1
+#include <immintrin.h>
+#endif
+
+// Lanes are processed in tiles so that the per-lane carries stay in L1 while
+// the limb rows stream through.
+static const size_t TILE_LANES = 512;
+
+static void add_rows_scalar(uint64_t* result, const uint64_t* lhs, const uint64_t* rhs, size_t limbs,
+                            size_t stride, size_t begin, size_t end, uint64_t* carries) {
+    for (size_t i = 0; i < limbs; i++) {
+        for (size_t k = begin; k < end; k++) {
+            uint64_t sum = lhs[i * stride + k] + rhs[i * stride + k];
+            uint64_t carry = (sum < lhs[i * stride + k]);
+            sum += carries[k - begin];
+            carry |= (sum < carries[k - begin]);
+            result[i * stride + k] = sum;
+            carries[k - begin] = carry;
+        }
+    }
+}
+
+static void mul_small_rows_scalar(uint64_t* result, const uint64_t* lhs, uint32_t factor, size_t limbs,
+                                  size_t stride, size_t begin, size_t end, uint64_t* carries) {
+    for (size_t i = 0; i < limbs; i++) {
+        for (size_t k = begin; k < end; k++) {
+            uint_detail::limb_wide_t product = uint_detail::limb_wide_t{lhs[i * stride + k]} * factor + carries[k - begin];
+            result[i * stride + k] = static_cast<uint64_t>(product);
+            carries[k - begin] = static_cast<uint64_t>(product >> 64);
+        }
+    }
+}
+
+#ifdef NUMBER_X86_KERNELS
+
+// Carry out of a + b (+ carry in) given the wrapped sum s, in bit 0 of each lane.
+__attribute__((target("avx2")))
+static inline __m256i carry_out(__m256i a, __m256i b, __m256i s) {
+    __m256i generated = _mm256_and_si256(a, b);
+    __m256i propagated = _mm256_andnot_si256(s, _mm256_or_si256(a, b));
+    return _mm256_srli_epi64(_mm256_or_si256(generated, propagated), 63);
+}
+
+__attribute__((target("avx2")))
+static void add_rows_avx2(uint64_t* result, const uint64_t* lhs, const uint64_t* rhs, size_t limbs,
+                          size_t stride, size_t begin, size_t end, uint64_t* carries) {
+    for (size_t i = 0; i < limbs; i++) {
+        for (size_t k = begin; k < end; k += BATCH_LANES) {
+            __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i * stride + k));
+            __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i * stride + k));
+            __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(carries + (k - begin)));
+            __m256i s = _mm256_add_epi64(_mm256_add_epi64(a, b), c);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i * stride + k), s);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(carries + (k - begin)), carry_out(a, b, s));
+        }
+    }
+}
+
+// Each limb is split into 32-bit halves so that _mm256_mul_epu32 can form
+// the 96-bit product limb * factor as lo * f + (hi * f << 32).
+__attribute__((target("avx2")))
+static void mul_small_rows_avx2(uint64_t* result, const uint64_t* lhs, uint32_t factor, size_t limbs,
+                                size_t stride, size_t begin, size_t end, uint64_t* carries) {
+    const __m256i multiplier = _mm256_set1_epi64x(factor);
+    for (size_t i = 0; i < limbs; i++) {
+        for (size_t k = begin; k < end; k += BATCH_LANES) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i * stride + k));
+            __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(carries + (k - begin)));
+            __m256i low_product = _mm256_mul_epu32(x, multiplier);
+            __m256i high_product = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), multiplier);
+            __m256i shifted = _mm256_slli_epi64(high_product, 32);
+            __m256i partial = _mm256_add_epi64(low_product, shifted);
+            __m256i first_carry = carry_out(low_product, shifted, partial);
+            __m256i sum = _mm256_add_epi64(partial, c);
+            __m256i second_carry = carry_out(partial, c, sum);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(result + i * stride + k), sum);
+            __m256i next = _mm256_add_epi64(_mm256_srli_epi64(high_product, 32),
+                                            _mm256_add_epi64(first_carry, second_carry));
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(carries + (k - begin)), next);
+        }
+    }
+}
+
+__attribute__((target("avx2")))
+static void compare_rows_avx2(int8_t* result, const uint64_t* lhs, const uint64_t* rhs, size_t limbs,
+                              size_t stride, size_t count) {
+    const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+    for (size_t k = 0; k < count; k += BATCH_LANES) {
+        __m256i greater = _mm256_setzero_si256();
+        __m256i less = _mm256_setzero_si256();
+        for (size_t i = limbs; i-- > 0;) {
+            __m256i a = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(lhs + i * stride + k)), sign);
+            __m256i b = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(rhs + i * stride + k)), sign);
+            __m256i undecided = _mm256_xor_si256(_mm256_or_si256(greater, less), _mm256_set1_epi64x(-1));
+            greater = _mm256_or_si256(greater, _mm256_and_si256(undecided, _mm256_cmpgt_epi64(a, b)));
+            less = _mm256_or_si256(less, _mm256_and_si256(undecided, _mm256_cmpgt_epi64(b, a)));
+        }
+        int greater_mask = _mm256_movemask_pd(_mm256_castsi256_pd(greater));
+        int less_mask = _mm256_movemask_pd(_mm256_castsi256_pd(less));
+        for (size_t lane = 0; lane < BATCH_LANES && k + lane < count; lane++) {
+            result[k + lane] = static_cast<int8_t>(((greater_mask >> lane) & 1) - ((less_mask >> lane) & 1));
+        }
+    }
+}
+
+#endif
+
+bool batch_uses_avx2() {
+#ifdef NUMBER_X86_KERNELS
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+#else
+    return false;
+#endif
+}
+
+void add_rows(uint64_t* result, const uint64_t* lhs, const uint64_t* rhs, size_t limbs, size_t stride) {
+    uint64_t carries[TILE_LANES];
+    for (size_t begin = 0; begin < stride; begin += TILE_LANES) {
+        size_t end = std::min(stride, begin + TILE_LANES);
+        std::fill(carries, carries + (end - begin), 0);
+#ifdef NUMBER_X86_KERNELS
+        if (batch_uses_avx2()) {
+            add_rows_avx2(result, lhs, rhs, limbs, stride, begin, end, carries);
+            continue;
+        }
+#endif
+        add_rows_scalar(result, lhs, rhs, limbs, stride, begin, end, carries);
+    }
+}
+
+void mul_small_rows(uint64_t* result, const uint64_t* lhs, uint32_t factor, size_t limbs, size_t stride) {
+    uint64_t carries[TILE_LANES];
+    for (size_t begin = 0; begin < stride; begin += TILE_LANES) {
+        size_t end = std::min(stride, begin + TILE_LANES);
+        std::fill(carries, carries + (end - begin), 0);
+#ifdef NUMBER_X86_KERNELS
+        if (batch_uses_avx2()) {
+            mul_small_rows_avx2(result, lhs, factor, limbs, stride, begin, end, carries);
+            continue;
+        }
+#endif
+        mul_small_rows_scalar(result, lhs, factor, limbs, stride, begin, end, carries);
+    }
+}
+
+void compare_rows(int8_t* result, const uint64_t* lhs, const uint64_t* rhs, size_t limbs, size_t stride,
+                  size_t count) {
+#ifdef NUMBER_X86_KERNELS
+    if (batch_uses_avx2()) {
+        compare_rows_avx2(result, lhs, rhs, limbs, stride, count);
+        return;
+    }
+#endif
+    for (size_t k = 0; k < count; k++) {
+        result[k] = 0;
+        for (size_t i = limbs; i-- > 0;) {
+            uint64_t a = lhs[i * stride + k];
+            uint64_t b = rhs[i * stride + k];
+            if (a != b) {
+                result[k] = (a > b) ? 1 : -1;
+                break;
+            }
+        }
+    }
+}
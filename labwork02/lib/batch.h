@@ -0,0 +1,99 @@
+#pragma once
+#include "number.h"
+#include <vector>
+
+// Row kernels over structure-of-arrays limbs: row i of a batch holds limb i of
+// every number, lanes [0, stride) with stride a multiple of BATCH_LANES.
+constexpr size_t BATCH_LANES = 4;
+
+void add_rows(uint64_t* result, const uint64_t* lhs, const uint64_t* rhs, size_t limbs, size_t stride);
+
+void mul_small_rows(uint64_t* result, const uint64_t* lhs, uint32_t factor, size_t limbs, size_t stride);
+
+void compare_rows(int8_t* result, const uint64_t* lhs, const uint64_t* rhs, size_t limbs, size_t stride,
+                  size_t count);
+
+bool batch_uses_avx2();
+
+template<size_t Bits, bool TrackSize = true>
+class uint_batch {
+public:
+    using value_type = uint_t<Bits, TrackSize>;
+
+    static constexpr size_t LIMBS = value_type::MAX_SIZE;
+
+    explicit uint_batch(size_t count)
+        : count_(count),
+          stride_((count + BATCH_LANES - 1) / BATCH_LANES * BATCH_LANES),
+          limbs_(LIMBS * stride_, 0) {
+    }
+
+    size_t size() const {
+        return count_;
+    }
+
+    size_t stride() const {
+        return stride_;
+    }
+
+    uint64_t* row(size_t limb) {
+        return limbs_.data() + limb * stride_;
+    }
+
+    const uint64_t* row(size_t limb) const {
+        return limbs_.data() + limb * stride_;
+    }
+
+    value_type get(size_t index) const {
+        value_type value;
+        for (size_t i = 0; i < LIMBS; i++) {
+            value.digits[i] = row(i)[index];
+        }
+        value.resize(LIMBS);
+        value.remove_zeros();
+        return value;
+    }
+
+    void set(size_t index, const value_type& value) {
+        for (size_t i = 0; i < LIMBS; i++) {
+            row(i)[index] = value.digits[i];
+        }
+    }
+
+    // Reduces every lane modulo 2^Bits after a kernel that works on whole limbs.
+    void clear_unused_bits() {
+        constexpr size_t TOP_BITS = Bits - (LIMBS - 1) * value_type::LIMB_BITS;
+        if constexpr (TOP_BITS < value_type::LIMB_BITS) {
+            uint64_t* top = row(LIMBS - 1);
+            for (size_t k = 0; k < stride_; k++) {
+                top[k] &= (uint64_t{1} << TOP_BITS) - 1;
+            }
+        }
+    }
+
+private:
+    size_t count_;
+    size_t stride_;
+    std::vector<uint64_t> limbs_;
+};
+
+// result[k] = lhs[k] + rhs[k] for every lane; result may alias either operand.
+template<size_t Bits, bool TrackSize>
+void add_n(uint_batch<Bits, TrackSize>& result, const uint_batch<Bits, TrackSize>& lhs,
+           const uint_batch<Bits, TrackSize>& rhs) {
+    add_rows(result.row(0), lhs.row(0), rhs.row(0), uint_batch<Bits, TrackSize>::LIMBS, result.stride());
+    result.clear_unused_bits();
+}
+
+// result[k] = lhs[k] * factor for every lane; result may alias lhs.
+template<size_t Bits, bool TrackSize>
+void mul_small_n(uint_batch<Bits, TrackSize>& result, const uint_batch<Bits, TrackSize>& lhs, uint32_t factor) {
+    mul_small_rows(result.row(0), lhs.row(0), factor, uint_batch<Bits, TrackSize>::LIMBS, result.stride());
+    result.clear_unused_bits();
+}
+
+// result[k] = -1, 0 or 1 as lhs[k] is less than, equal to or greater than rhs[k].
+template<size_t Bits, bool TrackSize>
+void compare_n(int8_t* result, const uint_batch<Bits, TrackSize>& lhs, const uint_batch<Bits, TrackSize>& rhs) {
+    compare_rows(result, lhs.row(0), rhs.row(0), uint_batch<Bits, TrackSize>::LIMBS, lhs.stride(), lhs.size());
+}
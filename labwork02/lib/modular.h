@@ -0,0 +1,240 @@
+#pragma once
+#include "number.h"
+
+namespace uint_detail {
+
+// Largest sliding window used by power(); the table holds 2^(MAX_WINDOW - 1) odd powers.
+constexpr size_t MAX_WINDOW = 6;
+
+// remainder = value[0, size) mod modulus, where size <= 2 * MAX_SIZE + 1: a
+// double-width product, or R^2 = 2^(128 n) for a modulus of all n = MAX_SIZE limbs.
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize> reduce_limbs(const uint64_t* value, size_t size,
+                                               const uint_t<Bits, TrackSize>& modulus) {
+    constexpr size_t MAX_SIZE = uint_t<Bits, TrackSize>::MAX_SIZE;
+    uint_t<Bits, TrackSize> remainder;
+    size_t modulus_size = modulus.significant_size();
+    while (size > 0 && value[size - 1] == 0) {
+        size--;
+    }
+    if (modulus_size == 0) {
+        return remainder;
+    }
+    if (size < modulus_size) {
+        std::copy(value, value + size, remainder.digits);
+        remainder.resize(size);
+        return remainder;
+    }
+    if (modulus_size == 1) {
+        limb_wide_t current = 0;
+        for (size_t i = size; i-- > 0;) {
+            current = ((current << 64) | value[i]) % modulus.digits[0];
+        }
+        remainder.digits[0] = static_cast<uint64_t>(current);
+        remainder.resize(remainder.digits[0] != 0);
+        return remainder;
+    }
+    uint64_t quotient[2 * MAX_SIZE + 1];
+    divide_knuth<2 * MAX_SIZE + 1>(value, size, modulus.digits, modulus_size, quotient, remainder.digits);
+    remainder.resize(modulus_size);
+    remainder.remove_zeros();
+    return remainder;
+}
+
+// Left-to-right sliding-window exponentiation: result = base^exponent, where
+// one is the identity and multiply(lhs, rhs) is the group operation.
+template<typename T, typename Multiply>
+constexpr T sliding_window_power(const T& base, const T& exponent, const T& one, Multiply multiply) {
+    size_t bits = exponent.significant_size() * T::LIMB_BITS;
+    while (bits > 0 && ((exponent.digits[(bits - 1) / T::LIMB_BITS] >> ((bits - 1) % T::LIMB_BITS)) & 1) == 0) {
+        bits--;
+    }
+    if (bits == 0) {
+        return one;
+    }
+    size_t window = 1;
+    while (window < MAX_WINDOW && bits > (size_t{1} << (2 * window + 1))) {
+        window++;
+    }
+    auto bit = [&exponent](size_t index) {
+        return (exponent.digits[index / T::LIMB_BITS] >> (index % T::LIMB_BITS)) & 1;
+    };
+
+    T odd_powers[size_t{1} << (MAX_WINDOW - 1)];
+    odd_powers[0] = base;
+    if (window > 1) {
+        T square = multiply(base, base);
+        for (size_t i = 1; i < (size_t{1} << (window - 1)); i++) {
+            odd_powers[i] = multiply(odd_powers[i - 1], square);
+        }
+    }
+
+    T result = one;
+    bool is_one = true;
+    size_t position = bits;
+    while (position > 0) {
+        if (bit(position - 1) == 0) {
+            if (!is_one) {
+                result = multiply(result, result);
+            }
+            position--;
+            continue;
+        }
+        size_t low = position > window ? position - window : 0;
+        while (bit(low) == 0) {
+            low++;
+        }
+        size_t chunk = 0;
+        for (size_t i = position; i-- > low;) {
+            chunk = (chunk << 1) | bit(i);
+        }
+        if (is_one) {
+            result = odd_powers[chunk >> 1];
+            is_one = false;
+        } else {
+            for (size_t i = low; i < position; i++) {
+                result = multiply(result, result);
+            }
+            result = multiply(result, odd_powers[chunk >> 1]);
+        }
+        position = low;
+    }
+    return result;
+}
+
+} // namespace uint_detail
+
+// lhs * rhs mod modulus, computed from the full double-width product.
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize> mulmod(const uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs,
+                                         const uint_t<Bits, TrackSize>& modulus) {
+    constexpr size_t MAX_SIZE = uint_t<Bits, TrackSize>::MAX_SIZE;
+    size_t lhs_size = lhs.significant_size();
+    size_t rhs_size = rhs.significant_size();
+    uint64_t product[2 * MAX_SIZE] = {};
+    if (std::min(lhs_size, rhs_size) >= uint_detail::KARATSUBA_THRESHOLD) {
+        uint_detail::multiply_karatsuba<MAX_SIZE>(lhs.digits, rhs.digits, std::max(lhs_size, rhs_size), product);
+    } else {
+        uint_detail::multiply_schoolbook(lhs.digits, lhs_size, rhs.digits, rhs_size, product, lhs_size + rhs_size);
+    }
+    return uint_detail::reduce_limbs(product, lhs_size + rhs_size, modulus);
+}
+
+// Montgomery arithmetic for a fixed odd modulus N with R = 2^(64 * n), where n
+// is the number of significant limbs of N. Values in Montgomery form are
+// x * R mod N; multiply() maps aR and bR to abR with no division at all.
+template<size_t Bits, bool TrackSize = true>
+class montgomery_context {
+public:
+    using value_type = uint_t<Bits, TrackSize>;
+
+    constexpr explicit montgomery_context(const value_type& modulus)
+        : modulus_(modulus),
+          size_(modulus.significant_size()) {
+        uint64_t inverse = 1;
+        for (int i = 0; i < 6; i++) {
+            inverse *= 2 - modulus.digits[0] * inverse;
+        }
+        inverse_ = 0 - inverse;
+
+        uint64_t r_squared[2 * value_type::MAX_SIZE + 1] = {};
+        r_squared[2 * size_] = 1;
+        r_squared_ = uint_detail::reduce_limbs(r_squared, 2 * size_ + 1, modulus_);
+        one_ = from_montgomery(r_squared_);
+    }
+
+    constexpr const value_type& modulus() const {
+        return modulus_;
+    }
+
+    // R mod N, the Montgomery form of 1.
+    constexpr const value_type& one() const {
+        return one_;
+    }
+
+    constexpr value_type to_montgomery(const value_type& value) const {
+        if (value < modulus_) {
+            return multiply(value, r_squared_);
+        }
+        return multiply(value % modulus_, r_squared_);
+    }
+
+    constexpr value_type from_montgomery(const value_type& value) const {
+        return multiply(value, from_uint<value_type>(1));
+    }
+
+    // lhs * rhs * R^-1 mod N for lhs, rhs < N (coarsely integrated operand scanning).
+    constexpr value_type multiply(const value_type& lhs, const value_type& rhs) const {
+        uint64_t t[value_type::MAX_SIZE + 2] = {};
+        const uint64_t* n = modulus_.digits;
+        for (size_t i = 0; i < size_; i++) {
+            uint64_t carry = 0;
+            for (size_t j = 0; j < size_; j++) {
+                uint_detail::limb_wide_t sum = uint_detail::limb_wide_t{lhs.digits[j]} * rhs.digits[i] + t[j] + carry;
+                t[j] = static_cast<uint64_t>(sum);
+                carry = static_cast<uint64_t>(sum >> 64);
+            }
+            uint_detail::limb_wide_t top = uint_detail::limb_wide_t{t[size_]} + carry;
+            t[size_] = static_cast<uint64_t>(top);
+            t[size_ + 1] = static_cast<uint64_t>(top >> 64);
+
+            uint64_t factor = t[0] * inverse_;
+            uint_detail::limb_wide_t sum = uint_detail::limb_wide_t{factor} * n[0] + t[0];
+            carry = static_cast<uint64_t>(sum >> 64);
+            for (size_t j = 1; j < size_; j++) {
+                sum = uint_detail::limb_wide_t{factor} * n[j] + t[j] + carry;
+                t[j - 1] = static_cast<uint64_t>(sum);
+                carry = static_cast<uint64_t>(sum >> 64);
+            }
+            top = uint_detail::limb_wide_t{t[size_]} + carry;
+            t[size_ - 1] = static_cast<uint64_t>(top);
+            t[size_] = t[size_ + 1] + static_cast<uint64_t>(top >> 64);
+        }
+
+        value_type result;
+        std::copy(t, t + size_, result.digits);
+        size_t top_difference = size_;
+        while (top_difference > 0 && t[top_difference - 1] == n[top_difference - 1]) {
+            top_difference--;
+        }
+        if (t[size_] != 0 || top_difference == 0 || t[top_difference - 1] > n[top_difference - 1]) {
+            uint_detail::subtract_limbs(result.digits, size_, n, size_);
+        }
+        result.resize(size_);
+        result.remove_zeros();
+        return result;
+    }
+
+    // base^exponent mod N; base and the result are in ordinary form.
+    constexpr value_type power(const value_type& base, const value_type& exponent) const {
+        value_type result = uint_detail::sliding_window_power(
+            to_montgomery(base), exponent, one_,
+            [this](const value_type& lhs, const value_type& rhs) { return multiply(lhs, rhs); });
+        return from_montgomery(result);
+    }
+
+private:
+    value_type modulus_;
+    size_t size_;
+    uint64_t inverse_ = 0;
+    value_type r_squared_;
+    value_type one_;
+};
+
+// base^exponent mod modulus. Odd moduli go through Montgomery multiplication,
+// even ones through mulmod; reuse a montgomery_context when the modulus repeats.
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize> powmod(const uint_t<Bits, TrackSize>& base, const uint_t<Bits, TrackSize>& exponent,
+                                         const uint_t<Bits, TrackSize>& modulus) {
+    if (modulus.is_zero()) {
+        return modulus;
+    }
+    if ((modulus.digits[0] & 1) != 0) {
+        return montgomery_context<Bits, TrackSize>(modulus).power(base, exponent);
+    }
+    return uint_detail::sliding_window_power(
+        base % modulus, exponent, from_uint<uint_t<Bits, TrackSize>>(1) % modulus,
+        [&modulus](const uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+            return mulmod(lhs, rhs, modulus);
+        });
+}
@@ -1,53 +1,918 @@
 #pragma once
+#include <algorithm>
+#include <charconv>
 #include <cinttypes>
 #include <iostream>
-#include <iomanip>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
 
 
-struct uint2022_t {
-
+template<bool TrackSize>
+struct uint_limb_count {
     size_t current_size = 0;
+};
+
+template<>
+struct uint_limb_count<false> {
+};
+
+// Fixed-width unsigned integer stored as little-endian 64-bit limbs. Limbs at
+// positions >= size() are always zero. With TrackSize the number of significant
+// limbs is kept in current_size and loops stop there; without it every loop
+// runs over all MAX_SIZE limbs, which the compiler can fully unroll.
+template<size_t Bits, bool TrackSize = true>
+struct uint_t : uint_limb_count<TrackSize> {
+
+    static constexpr size_t BITS = Bits;
 
-    static const size_t DIGIT_SIZE = 1000000000;
+    static constexpr size_t LIMB_BITS = 64;
 
-    static const size_t DIGIT_LEN = 9;
+    static constexpr size_t MAX_SIZE = (Bits + LIMB_BITS - 1) / LIMB_BITS;
 
-    static const size_t MAX_SIZE = 68;
+    static constexpr bool TRACK_SIZE = TrackSize;
 
-    uint32_t digits[MAX_SIZE];
+    uint64_t digits[MAX_SIZE] = {};
 
-    void digits_clear();
+    constexpr size_t size() const {
+        if constexpr (TrackSize) {
+            return this->current_size;
+        } else {
+            return MAX_SIZE;
+        }
+    }
 
-    void digit_shift();
+    constexpr void resize(size_t size) {
+        if constexpr (TrackSize) {
+            this->current_size = size;
+        }
+    }
 
-    void remove_zeros();
+    constexpr size_t significant_size() const {
+        size_t size = this->size();
+        while (size > 0 && digits[size - 1] == 0) {
+            size--;
+        }
+        return size;
+    }
+
+    constexpr bool is_zero() const {
+        return significant_size() == 0;
+    }
+
+    constexpr void digits_clear() {
+        std::fill(digits, digits + size(), 0);
+        resize(0);
+    }
+
+    constexpr void remove_zeros() {
+        if constexpr (TrackSize) {
+            this->current_size = significant_size();
+        }
+    }
 };
 
+using uint2022_t = uint_t<2022>;
+
+using uint256_t = uint_t<256, false>;
+
+using uint512_t = uint_t<512, false>;
+
+using uint4096_t = uint_t<4096>;
+
 static_assert(sizeof(uint2022_t) <= 300, "Size of uint2022_t must be no higher than 300 bytes");
 
-uint2022_t from_uint(uint32_t i);
+static_assert(sizeof(uint256_t) == 32, "Untracked uint_t must not store a size");
+
+namespace uint_detail {
+
+using limb_wide_t = unsigned __int128;
+
+constexpr uint64_t DECIMAL_CHUNK = 10000000000000000000ULL;
+
+constexpr size_t DECIMAL_CHUNK_LEN = 19;
+
+// Every operation works modulo 2^Bits: the bits of the top limb at and above
+// Bits are cleared after anything that can set them. Returns the cleared bits,
+// shifted down, so that callers can tell that a result did not fit.
+template<size_t Bits, bool TrackSize>
+constexpr uint64_t clear_unused_bits(uint_t<Bits, TrackSize>& value) {
+    constexpr size_t MAX_SIZE = uint_t<Bits, TrackSize>::MAX_SIZE;
+    constexpr size_t TOP_BITS = Bits - (MAX_SIZE - 1) * uint_t<Bits, TrackSize>::LIMB_BITS;
+    uint64_t cleared = 0;
+    if constexpr (TOP_BITS < uint_t<Bits, TrackSize>::LIMB_BITS) {
+        if (value.size() == MAX_SIZE) {
+            cleared = value.digits[MAX_SIZE - 1] >> TOP_BITS;
+            value.digits[MAX_SIZE - 1] &= (uint64_t{1} << TOP_BITS) - 1;
+        }
+    }
+    value.remove_zeros();
+    return cleared;
+}
+
+// Kernel timings on x86-64: Karatsuba loses to schoolbook up to 24 limbs,
+// breaks even at 32 and wins from 48. multiply_limbs only uses it for full
+// products, so uint2022_t products (at most 16 x 16 limbs) stay on schoolbook;
+// mulmod's double-width products and wider types reach it.
+constexpr size_t KARATSUBA_THRESHOLD = 32;
+
+// result[0, result_size) += lhs * rhs, keeping the lower result_size limbs.
+constexpr void multiply_schoolbook(const uint64_t* lhs, size_t lhs_size, const uint64_t* rhs, size_t rhs_size,
+                                   uint64_t* result, size_t result_size) {
+    for (size_t i = 0; i < rhs_size && i < result_size; i++) {
+        uint64_t carry = 0;
+        size_t j_end = std::min(lhs_size, result_size - i);
+        for (size_t j = 0; j < j_end; j++) {
+            limb_wide_t product = limb_wide_t{lhs[j]} * rhs[i] + result[i + j] + carry;
+            result[i + j] = static_cast<uint64_t>(product);
+            carry = static_cast<uint64_t>(product >> 64);
+        }
+        for (size_t k = i + j_end; carry != 0 && k < result_size; k++) {
+            result[k] += carry;
+            carry = (result[k] < carry);
+        }
+    }
+}
+
+// target += addend, returns the carry out of target_size limbs.
+constexpr uint64_t add_limbs(uint64_t* target, size_t target_size, const uint64_t* addend, size_t addend_size) {
+    uint64_t carry = 0;
+    for (size_t i = 0; i < target_size && (i < addend_size || carry != 0); i++) {
+        limb_wide_t sum = limb_wide_t{target[i]} + (i < addend_size ? addend[i] : 0) + carry;
+        target[i] = static_cast<uint64_t>(sum);
+        carry = static_cast<uint64_t>(sum >> 64);
+    }
+    return carry;
+}
+
+// target -= subtrahend, returns the borrow out of target_size limbs.
+constexpr uint64_t subtract_limbs(uint64_t* target, size_t target_size, const uint64_t* subtrahend,
+                                  size_t subtrahend_size) {
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < target_size && (i < subtrahend_size || borrow != 0); i++) {
+        limb_wide_t difference = limb_wide_t{target[i]} - (i < subtrahend_size ? subtrahend[i] : 0) - borrow;
+        target[i] = static_cast<uint64_t>(difference);
+        borrow = static_cast<uint64_t>(difference >> 64) & 1;
+    }
+    return borrow;
+}
+
+// result[0, 2 * size) = lhs[0, size) * rhs[0, size), size <= Limbs.
+template<size_t Limbs>
+constexpr void multiply_karatsuba(const uint64_t* lhs, const uint64_t* rhs, size_t size, uint64_t* result) {
+    if (size < KARATSUBA_THRESHOLD) {
+        std::fill(result, result + 2 * size, 0);
+        multiply_schoolbook(lhs, size, rhs, size, result, 2 * size);
+        return;
+    }
+    size_t low = size / 2;
+    size_t high = size - low;
+    multiply_karatsuba<Limbs>(lhs, rhs, low, result);
+    multiply_karatsuba<Limbs>(lhs + low, rhs + low, high, result + 2 * low);
+
+    uint64_t lhs_sum[Limbs + 1];
+    uint64_t rhs_sum[Limbs + 1];
+    std::copy(lhs + low, lhs + size, lhs_sum);
+    std::copy(rhs + low, rhs + size, rhs_sum);
+    lhs_sum[high] = add_limbs(lhs_sum, high, lhs, low);
+    rhs_sum[high] = add_limbs(rhs_sum, high, rhs, low);
+
+    uint64_t middle[2 * Limbs + 2];
+    multiply_karatsuba<Limbs>(lhs_sum, rhs_sum, high + 1, middle);
+    subtract_limbs(middle, 2 * high + 2, result, 2 * low);
+    subtract_limbs(middle, 2 * high + 2, result + 2 * low, 2 * high);
+    add_limbs(result + low, 2 * size - low, middle, std::min(2 * high + 2, 2 * size - low));
+}
+
+// product[0, MAX_SIZE) = lhs * rhs, product must be zeroed. Returns the product size.
+template<size_t Bits, bool TrackSize>
+constexpr size_t multiply_limbs(const uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs,
+                                uint64_t* product) {
+    constexpr size_t MAX_SIZE = uint_t<Bits, TrackSize>::MAX_SIZE;
+    if (lhs.size() == 0 || rhs.size() == 0) {
+        return 0;
+    }
+    size_t result_size = std::min(lhs.size() + rhs.size(), MAX_SIZE);
+    bool is_full_product = lhs.size() + rhs.size() <= MAX_SIZE;
+    if constexpr (MAX_SIZE >= 2 * KARATSUBA_THRESHOLD) {
+        if (is_full_product && std::min(lhs.size(), rhs.size()) >= KARATSUBA_THRESHOLD) {
+            size_t size = std::max(lhs.size(), rhs.size());
+            uint64_t full_product[2 * MAX_SIZE];
+            multiply_karatsuba<MAX_SIZE>(lhs.digits, rhs.digits, size, full_product);
+            std::copy(full_product, full_product + result_size, product);
+            return result_size;
+        }
+    }
+    multiply_schoolbook(lhs.digits, lhs.size(), rhs.digits, rhs.size(), product, result_size);
+    return result_size;
+}
+
+// Knuth, TAOCP vol. 2, 4.3.1, Algorithm D. The divisor has at least two limbs
+// and numerator_size >= divisor_size.
+template<size_t Limbs>
+constexpr void divide_knuth(const uint64_t* numerator, size_t numerator_size, const uint64_t* divisor,
+                            size_t divisor_size, uint64_t* quotient, uint64_t* remainder) {
+    const size_t n = divisor_size;
+    const size_t m = numerator_size - divisor_size;
+    const unsigned shift = __builtin_clzll(divisor[n - 1]);
+
+    uint64_t normalized_divisor[Limbs];
+    uint64_t normalized_numerator[Limbs + 1];
+    for (size_t i = n; i-- > 1;) {
+        normalized_divisor[i] = (divisor[i] << shift) | (shift ? divisor[i - 1] >> (64 - shift) : 0);
+    }
+    normalized_divisor[0] = divisor[0] << shift;
+    normalized_numerator[m + n] = shift ? numerator[m + n - 1] >> (64 - shift) : 0;
+    for (size_t i = m + n; i-- > 1;) {
+        normalized_numerator[i] = (numerator[i] << shift) | (shift ? numerator[i - 1] >> (64 - shift) : 0);
+    }
+    normalized_numerator[0] = numerator[0] << shift;
+
+    const uint64_t divisor_top = normalized_divisor[n - 1];
+    const uint64_t divisor_next = normalized_divisor[n - 2];
+    for (size_t j = m + 1; j-- > 0;) {
+        limb_wide_t top = (limb_wide_t{normalized_numerator[j + n]} << 64) | normalized_numerator[j + n - 1];
+        limb_wide_t estimate = top / divisor_top;
+        limb_wide_t estimate_remainder = top % divisor_top;
+        while ((estimate >> 64) != 0 ||
+               estimate * divisor_next > ((estimate_remainder << 64) | normalized_numerator[j + n - 2])) {
+            estimate--;
+            estimate_remainder += divisor_top;
+            if ((estimate_remainder >> 64) != 0) {
+                break;
+            }
+        }
+
+        uint64_t digit = static_cast<uint64_t>(estimate);
+        uint64_t carry = 0;
+        uint64_t borrow = 0;
+        for (size_t i = 0; i < n; i++) {
+            limb_wide_t product = limb_wide_t{digit} * normalized_divisor[i] + carry;
+            carry = static_cast<uint64_t>(product >> 64);
+            limb_wide_t difference = limb_wide_t{normalized_numerator[i + j]} - static_cast<uint64_t>(product) - borrow;
+            normalized_numerator[i + j] = static_cast<uint64_t>(difference);
+            borrow = static_cast<uint64_t>(difference >> 64) & 1;
+        }
+        limb_wide_t difference = limb_wide_t{normalized_numerator[j + n]} - carry - borrow;
+        normalized_numerator[j + n] = static_cast<uint64_t>(difference);
+
+        if ((static_cast<uint64_t>(difference >> 64) & 1) != 0) {
+            digit--;
+            normalized_numerator[j + n] += add_limbs(normalized_numerator + j, n, normalized_divisor, n);
+        }
+        quotient[j] = digit;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        remainder[i] = (normalized_numerator[i] >> shift) |
+                       (shift ? normalized_numerator[i + 1] << (64 - shift) : 0);
+    }
+}
+
+// value = value * factor + addend modulo 2^Bits. Returns non-zero if the result
+// did not fit.
+template<size_t Bits, bool TrackSize>
+constexpr uint64_t multiply_add_small(uint_t<Bits, TrackSize>& value, uint64_t factor, uint64_t addend) {
+    uint64_t carry = addend;
+    size_t size = value.size();
+    for (size_t i = 0; i < size; i++) {
+        limb_wide_t product = limb_wide_t{value.digits[i]} * factor + carry;
+        value.digits[i] = static_cast<uint64_t>(product);
+        carry = static_cast<uint64_t>(product >> 64);
+    }
+    if (carry != 0 && size < uint_t<Bits, TrackSize>::MAX_SIZE) {
+        value.digits[size] = carry;
+        value.resize(size + 1);
+        carry = 0;
+    }
+    return carry | clear_unused_bits(value);
+}
+
+// value /= divisor, returns the remainder.
+template<size_t Bits, bool TrackSize>
+constexpr uint64_t divide_small(uint_t<Bits, TrackSize>& value, uint64_t divisor) {
+    limb_wide_t remainder = 0;
+    for (size_t i = value.size(); i-- > 0;) {
+        limb_wide_t current = (remainder << 64) | value.digits[i];
+        value.digits[i] = static_cast<uint64_t>(current / divisor);
+        remainder = current % divisor;
+    }
+    value.remove_zeros();
+    return static_cast<uint64_t>(remainder);
+}
+
+} // namespace uint_detail
+
+template<typename T = uint2022_t>
+constexpr T from_uint(uint32_t i) {
+    T value;
+    value.digits[0] = i;
+    value.resize(i != 0);
+    return value;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr std::pair<uint_t<Bits, TrackSize>, uint_t<Bits, TrackSize>> divmod(const uint_t<Bits, TrackSize>& lhs,
+                                                                             const uint_t<Bits, TrackSize>& rhs) {
+    uint_t<Bits, TrackSize> quotient;
+    uint_t<Bits, TrackSize> remainder;
+    size_t lhs_size = lhs.significant_size();
+    size_t rhs_size = rhs.significant_size();
+    if (rhs_size == 0) {
+        return {quotient, remainder};
+    }
+    if (lhs < rhs) {
+        return {quotient, lhs};
+    }
+    if (rhs_size == 1) {
+        quotient = lhs;
+        remainder.digits[0] = uint_detail::divide_small(quotient, rhs.digits[0]);
+        remainder.resize(remainder.digits[0] != 0);
+        return {quotient, remainder};
+    }
+    uint_detail::divide_knuth<uint_t<Bits, TrackSize>::MAX_SIZE>(lhs.digits, lhs_size, rhs.digits, rhs_size,
+                                                                 quotient.digits, remainder.digits);
+    quotient.resize(lhs_size - rhs_size + 1);
+    quotient.remove_zeros();
+    remainder.resize(rhs_size);
+    remainder.remove_zeros();
+    return {quotient, remainder};
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize>& operator+=(uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+    size_t total_len = std::max(lhs.size(), rhs.size());
+    uint64_t carry = uint_detail::add_limbs(lhs.digits, total_len, rhs.digits, rhs.size());
+    lhs.resize(total_len);
+    if (carry != 0 && total_len < uint_t<Bits, TrackSize>::MAX_SIZE) {
+        lhs.digits[total_len] = carry;
+        lhs.resize(total_len + 1);
+    }
+    uint_detail::clear_unused_bits(lhs);
+    return lhs;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize>& operator-=(uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+    constexpr size_t MAX_SIZE = uint_t<Bits, TrackSize>::MAX_SIZE;
+    size_t total_len = std::max(lhs.size(), rhs.size());
+    uint64_t borrow = uint_detail::subtract_limbs(lhs.digits, total_len, rhs.digits, rhs.size());
+    lhs.resize(total_len);
+    if (borrow != 0) {
+        std::fill(lhs.digits + total_len, lhs.digits + MAX_SIZE, UINT64_MAX);
+        lhs.resize(MAX_SIZE);
+    }
+    uint_detail::clear_unused_bits(lhs);
+    return lhs;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize>& operator*=(uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+    uint64_t product[uint_t<Bits, TrackSize>::MAX_SIZE] = {};
+    size_t result_size = uint_detail::multiply_limbs(lhs, rhs, product);
+    std::copy(product, product + result_size, lhs.digits);
+    std::fill(lhs.digits + result_size, lhs.digits + std::max(result_size, lhs.size()), 0);
+    lhs.resize(result_size);
+    uint_detail::clear_unused_bits(lhs);
+    return lhs;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize>& operator/=(uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+    lhs = divmod(lhs, rhs).first;
+    return lhs;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize>& operator%=(uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+    lhs = divmod(lhs, rhs).second;
+    return lhs;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize>& operator++(uint_t<Bits, TrackSize>& value) {
+    for (size_t i = 0; i < uint_t<Bits, TrackSize>::MAX_SIZE; i++) {
+        if (++value.digits[i] != 0) {
+            value.resize(std::max(value.size(), i + 1));
+            uint_detail::clear_unused_bits(value);
+            return value;
+        }
+    }
+    value.resize(0);
+    return value;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize> operator++(uint_t<Bits, TrackSize>& value, int) {
+    uint_t<Bits, TrackSize> previous = value;
+    ++value;
+    return previous;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize>& operator--(uint_t<Bits, TrackSize>& value) {
+    for (size_t i = 0; i < uint_t<Bits, TrackSize>::MAX_SIZE; i++) {
+        if (value.digits[i]-- != 0) {
+            value.remove_zeros();
+            return value;
+        }
+    }
+    value.resize(uint_t<Bits, TrackSize>::MAX_SIZE);
+    uint_detail::clear_unused_bits(value);
+    return value;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize> operator--(uint_t<Bits, TrackSize>& value, int) {
+    uint_t<Bits, TrackSize> previous = value;
+    --value;
+    return previous;
+}
+
+// accumulator += value * factor in a single pass.
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize>& fused_multiply_add(uint_t<Bits, TrackSize>& accumulator,
+                                                      const uint_t<Bits, TrackSize>& value, uint64_t factor) {
+    if (factor == 0 || value.size() == 0) {
+        return accumulator;
+    }
+    uint64_t carry = 0;
+    for (size_t i = 0; i < value.size(); i++) {
+        uint_detail::limb_wide_t sum = uint_detail::limb_wide_t{value.digits[i]} * factor + accumulator.digits[i] + carry;
+        accumulator.digits[i] = static_cast<uint64_t>(sum);
+        carry = static_cast<uint64_t>(sum >> 64);
+    }
+    size_t i = value.size();
+    for (; carry != 0 && i < uint_t<Bits, TrackSize>::MAX_SIZE; i++) {
+        accumulator.digits[i] += carry;
+        carry = (accumulator.digits[i] < carry);
+    }
+    accumulator.resize(std::max(accumulator.size(), i));
+    uint_detail::clear_unused_bits(accumulator);
+    return accumulator;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize> operator+(const uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+    uint_t<Bits, TrackSize> value = lhs;
+    value += rhs;
+    return value;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize> operator-(const uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+    uint_t<Bits, TrackSize> value = lhs;
+    value -= rhs;
+    return value;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize> operator*(const uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+    uint_t<Bits, TrackSize> value;
+    value.resize(uint_detail::multiply_limbs(lhs, rhs, value.digits));
+    uint_detail::clear_unused_bits(value);
+    return value;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize> operator/(const uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+    return divmod(lhs, rhs).first;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize> operator%(const uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+    return divmod(lhs, rhs).second;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr bool operator==(const uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < lhs.size(); i++) {
+        if (lhs.digits[i] != rhs.digits[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr bool operator!=(const uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+    return !(lhs == rhs);
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr bool operator>=(const uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+    if (lhs.size() != rhs.size()) {
+        return lhs.size() > rhs.size();
+    }
+    for (size_t i = lhs.size(); i-- > 0;) {
+        if (lhs.digits[i] != rhs.digits[i]) {
+            return lhs.digits[i] > rhs.digits[i];
+        }
+    }
+    return true;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr bool operator<(const uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+    return !(lhs >= rhs);
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr bool operator>(const uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+    return (rhs < lhs);
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr bool operator<=(const uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+    return (rhs >= lhs);
+}
+
+// Bitwise operators keep values below 2^Bits like the arithmetic operators:
+// ~ and << clear what they set at and above Bits.
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize>& operator&=(uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+    size_t size = std::min(lhs.size(), rhs.size());
+    for (size_t i = 0; i < size; i++) {
+        lhs.digits[i] &= rhs.digits[i];
+    }
+    std::fill(lhs.digits + size, lhs.digits + lhs.size(), 0);
+    lhs.resize(size);
+    lhs.remove_zeros();
+    return lhs;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize>& operator|=(uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+    for (size_t i = 0; i < rhs.size(); i++) {
+        lhs.digits[i] |= rhs.digits[i];
+    }
+    lhs.resize(std::max(lhs.size(), rhs.size()));
+    return lhs;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize>& operator^=(uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+    for (size_t i = 0; i < rhs.size(); i++) {
+        lhs.digits[i] ^= rhs.digits[i];
+    }
+    lhs.resize(std::max(lhs.size(), rhs.size()));
+    lhs.remove_zeros();
+    return lhs;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize>& operator<<=(uint_t<Bits, TrackSize>& value, size_t shift) {
+    constexpr size_t MAX_SIZE = uint_t<Bits, TrackSize>::MAX_SIZE;
+    size_t limb_shift = shift / uint_t<Bits, TrackSize>::LIMB_BITS;
+    unsigned bit_shift = shift % uint_t<Bits, TrackSize>::LIMB_BITS;
+    if (limb_shift >= MAX_SIZE) {
+        value.digits_clear();
+        return value;
+    }
+    size_t size = std::min(value.size() + limb_shift + (bit_shift != 0), MAX_SIZE);
+    for (size_t i = size; i-- > limb_shift;) {
+        uint64_t carried = (bit_shift != 0 && i > limb_shift) ? value.digits[i - limb_shift - 1] >> (64 - bit_shift)
+                                                               : 0;
+        value.digits[i] = (value.digits[i - limb_shift] << bit_shift) | carried;
+    }
+    std::fill(value.digits, value.digits + limb_shift, 0);
+    value.resize(size);
+    uint_detail::clear_unused_bits(value);
+    return value;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize>& operator>>=(uint_t<Bits, TrackSize>& value, size_t shift) {
+    size_t limb_shift = shift / uint_t<Bits, TrackSize>::LIMB_BITS;
+    unsigned bit_shift = shift % uint_t<Bits, TrackSize>::LIMB_BITS;
+    size_t old_size = value.size();
+    if (limb_shift >= old_size) {
+        value.digits_clear();
+        return value;
+    }
+    size_t size = old_size - limb_shift;
+    for (size_t i = 0; i < size; i++) {
+        uint64_t carried = (bit_shift != 0 && i + 1 < size) ? value.digits[i + limb_shift + 1] << (64 - bit_shift) : 0;
+        value.digits[i] = (value.digits[i + limb_shift] >> bit_shift) | carried;
+    }
+    std::fill(value.digits + size, value.digits + old_size, 0);
+    value.resize(size);
+    value.remove_zeros();
+    return value;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize> operator&(const uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+    uint_t<Bits, TrackSize> result = lhs;
+    result &= rhs;
+    return result;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize> operator|(const uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+    uint_t<Bits, TrackSize> result = lhs;
+    result |= rhs;
+    return result;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize> operator^(const uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+    uint_t<Bits, TrackSize> result = lhs;
+    result ^= rhs;
+    return result;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize> operator~(const uint_t<Bits, TrackSize>& value) {
+    uint_t<Bits, TrackSize> result;
+    for (size_t i = 0; i < uint_t<Bits, TrackSize>::MAX_SIZE; i++) {
+        result.digits[i] = ~value.digits[i];
+    }
+    result.resize(uint_t<Bits, TrackSize>::MAX_SIZE);
+    uint_detail::clear_unused_bits(result);
+    return result;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize> operator<<(const uint_t<Bits, TrackSize>& value, size_t shift) {
+    uint_t<Bits, TrackSize> result = value;
+    result <<= shift;
+    return result;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize> operator>>(const uint_t<Bits, TrackSize>& value, size_t shift) {
+    uint_t<Bits, TrackSize> result = value;
+    result >>= shift;
+    return result;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr size_t popcount(const uint_t<Bits, TrackSize>& value) {
+    size_t count = 0;
+    for (size_t i = 0; i < value.size(); i++) {
+        count += __builtin_popcountll(value.digits[i]);
+    }
+    return count;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr size_t bit_width(const uint_t<Bits, TrackSize>& value) {
+    size_t size = value.significant_size();
+    if (size == 0) {
+        return 0;
+    }
+    return size * uint_t<Bits, TrackSize>::LIMB_BITS - __builtin_clzll(value.digits[size - 1]);
+}
+
+// Leading zero bits counted over the declared Bits width.
+template<size_t Bits, bool TrackSize>
+constexpr size_t countl_zero(const uint_t<Bits, TrackSize>& value) {
+    return Bits - bit_width(value);
+}
+
+// Trailing zero bits; zero has all Bits bits clear.
+template<size_t Bits, bool TrackSize>
+constexpr size_t countr_zero(const uint_t<Bits, TrackSize>& value) {
+    for (size_t i = 0; i < value.size(); i++) {
+        if (value.digits[i] != 0) {
+            return i * uint_t<Bits, TrackSize>::LIMB_BITS + __builtin_ctzll(value.digits[i]);
+        }
+    }
+    return Bits;
+}
+
+namespace uint_detail {
+
+constexpr size_t FROM_CHARS_THRESHOLD = 8 * DECIMAL_CHUNK_LEN;
+
+constexpr size_t TO_CHARS_THRESHOLD = 8;
+
+// Number of decimal digits of 2^BITS, the most a value of T can have.
+template<typename T>
+constexpr size_t max_decimal_digits() {
+    return static_cast<size_t>(T::BITS * 0.30102999566398119521L) + 1;
+}
+
+// powers[j] = 10^(19 * 2^j) for every j where it fits; count is the number of entries.
+template<typename T>
+struct decimal_powers {
+    T powers[16];
+    size_t count = 0;
+
+    decimal_powers() {
+        T power;
+        power.digits[0] = DECIMAL_CHUNK;
+        power.resize(1);
+        while (count < 16) {
+            powers[count++] = power;
+            if (2 * bit_width(power) > T::BITS) {
+                break;
+            }
+            power *= power;
+        }
+    }
+};
+
+template<typename T>
+const decimal_powers<T>& get_decimal_powers() {
+    static const decimal_powers<T> powers;
+    return powers;
+}
+
+constexpr uint64_t parse_chunk(const char* first, const char* last) {
+    uint64_t chunk = 0;
+    for (; first != last; first++) {
+        chunk = chunk * 10 + (*first - '0');
+    }
+    return chunk;
+}
+
+// Parses the digits [first, last) chunk by chunk. Returns false if the value does not fit.
+template<size_t Bits, bool TrackSize>
+constexpr bool parse_decimal_naive(const char* first, const char* last, uint_t<Bits, TrackSize>& value) {
+    value.digits_clear();
+    size_t chunk_len = (last - first) % DECIMAL_CHUNK_LEN;
+    if (chunk_len == 0) {
+        chunk_len = DECIMAL_CHUNK_LEN;
+    }
+    uint64_t overflow = 0;
+    for (const char* chunk = first; chunk != last; chunk += chunk_len, chunk_len = DECIMAL_CHUNK_LEN) {
+        uint64_t factor = 1;
+        for (size_t i = 0; i < chunk_len; i++) {
+            factor *= 10;
+        }
+        overflow |= multiply_add_small(value, factor, parse_chunk(chunk, chunk + chunk_len));
+    }
+    return overflow == 0;
+}
+
+// Parses the digits [first, last), which must fit, as high * 10^(19 * 2^k) + low.
+template<size_t Bits, bool TrackSize>
+constexpr void parse_decimal(const char* first, const char* last, uint_t<Bits, TrackSize>& value) {
+    size_t length = last - first;
+    if (length <= FROM_CHARS_THRESHOLD || std::is_constant_evaluated()) {
+        parse_decimal_naive(first, last, value);
+        return;
+    }
+    const decimal_powers<uint_t<Bits, TrackSize>>& table = get_decimal_powers<uint_t<Bits, TrackSize>>();
+    size_t level = 0;
+    while (level + 1 < table.count && (DECIMAL_CHUNK_LEN << (level + 1)) < length) {
+        level++;
+    }
+    size_t low_length = DECIMAL_CHUNK_LEN << level;
+    uint_t<Bits, TrackSize> low;
+    parse_decimal(last - low_length, last, low);
+    parse_decimal(first, last - low_length, value);
+    value *= table.powers[level];
+    value += low;
+}
 
-uint2022_t from_string(const char* buff);
+constexpr char* write_chunk(uint64_t chunk, char* end, size_t width) {
+    char* position = end;
+    while (chunk != 0 || static_cast<size_t>(end - position) < width) {
+        *--position = static_cast<char>('0' + chunk % 10);
+        chunk /= 10;
+    }
+    return position;
+}
 
-uint2022_t operator+(const uint2022_t& lhs, const uint2022_t& rhs);
+// Writes value in decimal so that it ends right before end, zero-padded to at
+// least width digits. Returns the first written character.
+template<size_t Bits, bool TrackSize>
+constexpr char* write_decimal(const uint_t<Bits, TrackSize>& value, char* end, size_t width) {
+    size_t size = value.significant_size();
+    char* position = end;
+    if (size <= TO_CHARS_THRESHOLD || std::is_constant_evaluated()) {
+        uint_t<Bits, TrackSize> rest = value;
+        while (!rest.is_zero()) {
+            uint64_t chunk = divide_small(rest, DECIMAL_CHUNK);
+            position = write_chunk(chunk, position, rest.is_zero() ? 0 : DECIMAL_CHUNK_LEN);
+        }
+        while (static_cast<size_t>(end - position) < width) {
+            *--position = '0';
+        }
+        return position;
+    }
+    const decimal_powers<uint_t<Bits, TrackSize>>& table = get_decimal_powers<uint_t<Bits, TrackSize>>();
+    size_t level = 0;
+    while (level + 1 < table.count && 2 * table.powers[level + 1].significant_size() <= size + 1) {
+        level++;
+    }
+    size_t low_width = DECIMAL_CHUNK_LEN << level;
+    std::pair<uint_t<Bits, TrackSize>, uint_t<Bits, TrackSize>> parts = divmod(value, table.powers[level]);
+    position = write_decimal(parts.second, position, low_width);
+    return write_decimal(parts.first, position, width > low_width ? width - low_width : 0);
+}
 
-uint2022_t operator-(const uint2022_t& lhs, const uint2022_t& rhs);
+} // namespace uint_detail
 
-uint2022_t operator*(const uint2022_t& lhs, const uint2022_t& rhs);
+// Parses the longest run of decimal digits at first, like std::from_chars.
+// Never allocates; long inputs are split in halves at powers of 10^19.
+template<size_t Bits, bool TrackSize>
+constexpr std::from_chars_result from_chars(const char* first, const char* last, uint_t<Bits, TrackSize>& value) {
+    const char* digits_end = first;
+    while (digits_end != last && *digits_end >= '0' && *digits_end <= '9') {
+        digits_end++;
+    }
+    if (digits_end == first) {
+        return {first, std::errc::invalid_argument};
+    }
+    const char* significant = first;
+    while (significant + 1 != digits_end && *significant == '0') {
+        significant++;
+    }
+    constexpr size_t max_digits = uint_detail::max_decimal_digits<uint_t<Bits, TrackSize>>();
+    size_t length = digits_end - significant;
+    if (length > max_digits) {
+        return {digits_end, std::errc::result_out_of_range};
+    }
+    uint_t<Bits, TrackSize> result;
+    if (length < max_digits) {
+        uint_detail::parse_decimal(significant, digits_end, result);
+    } else if (!uint_detail::parse_decimal_naive(significant, digits_end, result)) {
+        return {digits_end, std::errc::result_out_of_range};
+    }
+    value = result;
+    return {digits_end, std::errc()};
+}
 
-uint2022_t operator/(const uint2022_t& lhs, const uint2022_t& rhs);
+// Writes value in decimal to [first, last) without a terminating zero, like
+// std::to_chars. Wide values are split by divmod at powers of 10^19.
+template<size_t Bits, bool TrackSize>
+constexpr std::to_chars_result to_chars(char* first, char* last, const uint_t<Bits, TrackSize>& value) {
+    char buffer[uint_detail::max_decimal_digits<uint_t<Bits, TrackSize>>()];
+    char* end = buffer + sizeof(buffer);
+    char* start = value.is_zero() ? end - 1 : uint_detail::write_decimal(value, end, 0);
+    if (value.is_zero()) {
+        *start = '0';
+    }
+    size_t length = end - start;
+    if (static_cast<size_t>(last - first) < length) {
+        return {last, std::errc::value_too_large};
+    }
+    std::copy(start, end, first);
+    return {first + length, std::errc()};
+}
 
-bool operator==(const uint2022_t& lhs, const uint2022_t& rhs);
+// Throws std::invalid_argument unless the whole string is decimal digits and
+// std::out_of_range if the value does not fit, like the std::stoul it replaced.
+template<typename T = uint2022_t>
+constexpr T from_string(const char* buff) {
+    T value;
+    const char* end = buff + std::char_traits<char>::length(buff);
+    std::from_chars_result parsed = from_chars(buff, end, value);
+    if (parsed.ec == std::errc::result_out_of_range) {
+        throw std::out_of_range("from_string: value does not fit");
+    }
+    if (parsed.ec != std::errc() || parsed.ptr != end) {
+        throw std::invalid_argument("from_string: not a decimal number");
+    }
+    return value;
+}
 
-bool operator!=(const uint2022_t& lhs, const uint2022_t& rhs);
+namespace uint_detail {
 
-bool operator>=(const uint2022_t& lhs, const uint2022_t& rhs);
+// Parses the characters of a numeric literal at compile time; digit separators
+// are skipped and anything that is not a decimal digit or does not fit is a
+// compile error.
+template<typename T, char... Chars>
+consteval T parse_literal() {
+    constexpr char digits[] = {Chars...};
+    T value;
+    for (char digit : digits) {
+        if (digit == '\'') {
+            continue;
+        }
+        if (digit < '0' || digit > '9') {
+            throw "uint_t literals must be decimal";
+        }
+        if (multiply_add_small(value, 10, digit - '0') != 0) {
+            throw "uint_t literal is out of range";
+        }
+    }
+    return value;
+}
 
-bool operator<(const uint2022_t& lhs, const uint2022_t& rhs);
+} // namespace uint_detail
 
-bool operator>(const uint2022_t& lhs, const uint2022_t& rhs);
+template<char... Chars>
+consteval uint2022_t operator""_u2022() {
+    return uint_detail::parse_literal<uint2022_t, Chars...>();
+}
 
-bool operator<=(const uint2022_t& lhs, const uint2022_t& rhs);
+template<char... Chars>
+consteval uint4096_t operator""_u4096() {
+    return uint_detail::parse_literal<uint4096_t, Chars...>();
+}
 
-std::ostream& operator<<(std::ostream& stream, const uint2022_t& value);
+template<size_t Bits, bool TrackSize>
+std::ostream& operator<<(std::ostream& stream, const uint_t<Bits, TrackSize>& value) {
+    char buffer[uint_detail::max_decimal_digits<uint_t<Bits, TrackSize>>()];
+    std::to_chars_result result = to_chars(buffer, buffer + sizeof(buffer), value);
+    return stream.write(buffer, result.ptr - buffer);
+}
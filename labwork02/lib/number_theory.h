@@ -0,0 +1,86 @@
+#pragma once
+#include "modular.h"
+
+namespace uint_detail {
+
+// Limb-count gap at which binary GCD hands over to one Euclidean step: each
+// binary step strips only a few bits, a remainder strips the whole gap.
+constexpr size_t GCD_EUCLID_GAP = 2;
+
+} // namespace uint_detail
+
+// Stein's binary GCD on whole limbs: trailing zeros are stripped with one
+// shift and the larger odd operand is reduced by in-place limb subtraction.
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize> gcd(const uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+    if (lhs.is_zero()) {
+        return rhs;
+    }
+    if (rhs.is_zero()) {
+        return lhs;
+    }
+    uint_t<Bits, TrackSize> values[2] = {lhs, rhs};
+    size_t common_shift = std::min(countr_zero(lhs), countr_zero(rhs));
+    values[0] >>= countr_zero(values[0]);
+    values[1] >>= countr_zero(values[1]);
+    uint_t<Bits, TrackSize>* small = &values[0];
+    uint_t<Bits, TrackSize>* large = &values[1];
+    while (true) {
+        if (*large < *small) {
+            std::swap(small, large);
+        }
+        if (large->significant_size() >= small->significant_size() + uint_detail::GCD_EUCLID_GAP) {
+            *large %= *small;
+            if (large->is_zero()) {
+                break;
+            }
+        } else {
+            uint_detail::subtract_limbs(large->digits, large->size(), small->digits, small->size());
+            large->remove_zeros();
+            if (large->is_zero()) {
+                break;
+            }
+        }
+        *large >>= countr_zero(*large);
+    }
+    *small <<= common_shift;
+    return *small;
+}
+
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize> lcm(const uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) {
+    if (lhs.is_zero() || rhs.is_zero()) {
+        return uint_t<Bits, TrackSize>();
+    }
+    return lhs / gcd(lhs, rhs) * rhs;
+}
+
+// floor(sqrt(value)) by Newton's iteration x = (x + value / x) / 2, started
+// from a power of two above the root so the sequence decreases monotonically.
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize> isqrt(const uint_t<Bits, TrackSize>& value) {
+    if (value.significant_size() <= 1 && value.digits[0] <= 1) {
+        return value;
+    }
+    uint_t<Bits, TrackSize> root;
+    root.digits[0] = 1;
+    root.resize(1);
+    root <<= (bit_width(value) + 1) / 2;
+    while (true) {
+        uint_t<Bits, TrackSize> next = value / root;
+        next += root;
+        next >>= 1;
+        if (!(next < root)) {
+            return root;
+        }
+        root = next;
+    }
+}
+
+// base^exponent modulo 2^Bits by square-and-multiply over a sliding window.
+template<size_t Bits, bool TrackSize>
+constexpr uint_t<Bits, TrackSize> pow(const uint_t<Bits, TrackSize>& base, const uint_t<Bits, TrackSize>& exponent) {
+    return uint_detail::sliding_window_power(
+        base, exponent, from_uint<uint_t<Bits, TrackSize>>(1),
+        [](const uint_t<Bits, TrackSize>& lhs, const uint_t<Bits, TrackSize>& rhs) { return lhs * rhs; });
+}
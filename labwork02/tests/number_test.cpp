@@ -1,6 +1,10 @@
 #include <lib/number.h>
+#include <lib/batch.h>
+#include <lib/modular.h>
+#include <lib/number_theory.h>
 #include <gtest/gtest.h>
 #include <tuple>
+#include <sstream>
 
 class ConvertingTestsSuite : public testing::TestWithParam<std::tuple<uint32_t, const char*, bool>> {
 };
@@ -83,6 +87,22 @@ TEST_P(OperationTestsSuite, MultTest) {
     ASSERT_EQ(result, expected);
 }
 
+TEST_P(OperationTestsSuite, CompoundAssignTest) {
+    uint2022_t a = from_string(std::get<0>(GetParam()));
+    uint2022_t b = from_string(std::get<1>(GetParam()));
+
+    uint2022_t sum = a;
+    sum += b;
+    uint2022_t difference = a;
+    difference -= b;
+    uint2022_t product = a;
+    product *= b;
+
+    ASSERT_EQ(sum, from_string(std::get<2>(GetParam())));
+    ASSERT_EQ(difference, from_string(std::get<3>(GetParam())));
+    ASSERT_EQ(product, from_string(std::get<4>(GetParam())));
+}
+
 INSTANTIATE_TEST_SUITE_P(
     Group,
     OperationTestsSuite,
@@ -107,6 +127,501 @@ INSTANTIATE_TEST_SUITE_P(
             "405272312330606683982498447530407677486444946329741977764879002871583477858493",
             "405272312330606683982498447530407677486444946329741970511324085183808429621437",
             "1469832487054184013178321496623041557517329857560238757278117847507488415462666081345922349701550571520"
+        ),
+        std::make_tuple(
+            "89884656743115795386465259539451236680898848947115328636715040578866337902750481566354238661203768010560056939935696678829394884407208311246423715319737062188883946712432742638151109800623047059726541476042502884419075341171231440736956555270413618581675255342293149119973622969239858152417678164812112056263",
+            "18739277038847939886754019920358123424308469030992781557966909983211910963157763678726120154469030856807730587971859910379069087693119051085139566217370635083384943613868029545256897117998608156843699465093293765833141309526696357142600866935689483770877815014461194837692223879905132001",
+            "89884656743115795386483998816490084620785602967035686760139349047897330684308448476337450572166925774238783060090165709686202614995180171156802784407430181239969086278650113273234494744236915089271798373160501492575919040636324734502789696579940314938817856209228838603744500784254319347255370388692017188264",
+            "89884656743115795386446520262412388741012094927194970513290732109835345121192514656371026750240610246881330819781227647972587153819236451336044646232043943137798807146215372003067724857009179030181284578924504276262231641706138146971123413960886922224532654475357459636202745154225396957579985940932206924262",
+            "1684373484250998474720376334616009126425588681528737461082208385090646396438059830806197334026416442953239460839050592266856701969808887338016372647139930424209526528868012856760876359289867809982670122367598221941680362721241943717445280510736782618297391075764890558816776868936535208888855769214547025149592329867641317406379582779388040741399263061495930334662838924152076536179710150514362465783803827313331278945984458341114583580718858523390159626624108632902935597189846550555971854664019910431938487408156452538587141628539378240320519073722922757731027953969766652990434878698553772263"
         )
     )
-);
\ No newline at end of file
+);
+class DivisionTestsSuite
+    : public testing::TestWithParam<
+        std::tuple<
+            const char*, // lhs
+            const char*, // rhs
+            const char*, // /
+            const char*  // %
+        >
+    > {
+};
+
+TEST_P(DivisionTestsSuite, DivTest) {
+    uint2022_t a = from_string(std::get<0>(GetParam()));
+    uint2022_t b = from_string(std::get<1>(GetParam()));
+
+    uint2022_t result = a / b;
+    uint2022_t expected = from_string((std::get<2>(GetParam())));
+
+    ASSERT_EQ(result, expected);
+}
+
+TEST_P(DivisionTestsSuite, ModTest) {
+    uint2022_t a = from_string(std::get<0>(GetParam()));
+    uint2022_t b = from_string(std::get<1>(GetParam()));
+
+    uint2022_t result = a % b;
+    uint2022_t expected = from_string((std::get<3>(GetParam())));
+
+    ASSERT_EQ(result, expected);
+}
+
+TEST_P(DivisionTestsSuite, DivModTest) {
+    uint2022_t a = from_string(std::get<0>(GetParam()));
+    uint2022_t b = from_string(std::get<1>(GetParam()));
+
+    std::pair<uint2022_t, uint2022_t> result = divmod(a, b);
+
+    ASSERT_EQ(result.first, from_string(std::get<2>(GetParam())));
+    ASSERT_EQ(result.second, from_string(std::get<3>(GetParam())));
+    ASSERT_EQ(result.first * b + result.second, a);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Group,
+    DivisionTestsSuite,
+    testing::Values(
+        std::make_tuple("0", "7", "0", "0"),
+        std::make_tuple("7", "8", "0", "7"),
+        std::make_tuple("1024", "2", "512", "0"),
+        std::make_tuple("18446744073709551616", "18446744073709551615", "1", "1"),
+        std::make_tuple("340282366920938463463374607431768211456", "18446744073709551616", "18446744073709551616", "0"),
+        std::make_tuple("1469832487054184013178321496623041557517329857560238757278117847507488415462666081345922349701550571520",
+                        "3626777458843887524118528",
+                        "405272312330606683982498447530407677486444946329741974138101544027695953739965",
+                        "0"
+        ),
+        std::make_tuple("405272312330606683982498447530407677486444946329741977764879002871583477858493",
+                        "405272312330606683982498447530407677486444946329741970511324085183808429621437",
+                        "1",
+                        "7253554917687775048237056"
+        ),
+        std::make_tuple("340282366920938463463374607431768211455", "18446744073709551617", "18446744073709551615", "0"),
+        std::make_tuple("114813069527425452423283320117768198402231770208869520047764273682576626139237031385665948631650626991844596463898746277344711896086305533142593135616700393201240423184059907588649060006233568887309257818887562042806406427496951686150974106927051323232558146964957836326343924154564781609290335260888337382192058865469787602866866287519497521847471458684769141346157981288786954474761664911150582843961871651547147860462531029031765172515649292961426470108216046130772615631022298799893086710491947774889055129147098798825390779646484717842583785735882800228791057859703276953356352169285868564357578751",
+                        "10715086071862673209484250490600018105614048117055336074437503883703510511249361224931983788156958581275946729175531468251871452856923140435984577574698574803934567774824230985421074605062371141877954182153046474983581941267398767559165543946077062914571196477686542167660429831652624386837205668069383",
+                        "10715086071862673209484250490600018105614048117055336074437503883703510511249361224931983788156958581275946729175531468251871452856923140435984577574701848194542463916694244175117902204214587783923997246942529766351678075063803442114048814038402967071722083161814102238669647088198509779890534195658744",
+                        "10715086071862673209484250490600018105614048117055336074437503883703510511249361224931983788156958581275946729175531468251871452856923140435984577574675661069679294781734138657543281410996854647555652728626663435406909004692566045674982653299795733814514989688793621670595909035831426635463905974943799"
+        )
+    )
+);
+
+class OutputTestsSuite : public testing::TestWithParam<const char*> {
+};
+
+TEST_P(OutputTestsSuite, RoundTripTest) {
+    std::stringstream stream;
+    stream << from_string(GetParam());
+
+    ASSERT_EQ(stream.str(), GetParam());
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    Group,
+    OutputTestsSuite,
+    testing::Values(
+        "0",
+        "9",
+        "10000000000000000000",
+        "18446744073709551616",
+        "100000000000000000000000000000000000000000000000000000000000000000000000000000001",
+        "1469832487054184013178321496623041557517329857560238757278117847507488415462666081345922349701550571520"
+    )
+);
+
+TEST(CharConvTests, WideRoundTripTest) {
+    std::string digits;
+    while (digits.size() < 600) {
+        digits += "9876543210";
+    }
+    uint2022_t value;
+    std::from_chars_result parsed = from_chars(digits.data(), digits.data() + digits.size(), value);
+    ASSERT_EQ(parsed.ec, std::errc());
+    ASSERT_EQ(parsed.ptr, digits.data() + digits.size());
+
+    char buffer[700];
+    std::to_chars_result written = to_chars(buffer, buffer + sizeof(buffer), value);
+    ASSERT_EQ(written.ec, std::errc());
+    ASSERT_EQ(std::string(buffer, written.ptr), digits);
+
+    uint4096_t wide = from_string<uint4096_t>(digits.c_str());
+    wide *= wide;
+    std::stringstream stream;
+    stream << wide;
+    ASSERT_EQ(from_string<uint4096_t>(stream.str().c_str()), wide);
+    ASSERT_EQ(stream.str().size(), 1200);
+}
+
+TEST(CharConvTests, ErrorTest) {
+    uint2022_t value = from_uint(7);
+    const char* text = "x12";
+    ASSERT_EQ(from_chars(text, text + 3, value).ec, std::errc::invalid_argument);
+    ASSERT_EQ(from_chars(text + 1, text + 3, value).ptr, text + 3);
+    ASSERT_EQ(value, from_uint(12));
+
+    uint2022_t max_value = from_uint(0);
+    --max_value;
+    char buffer[700];
+    std::to_chars_result written = to_chars(buffer, buffer + sizeof(buffer), max_value);
+    ASSERT_EQ(from_chars(buffer, written.ptr, value).ec, std::errc());
+    ASSERT_EQ(value, max_value);
+
+    *written.ptr = '0';
+    ASSERT_EQ(from_chars(buffer, written.ptr + 1, value).ec, std::errc::result_out_of_range);
+    buffer[0]++;
+    ASSERT_EQ(from_chars(buffer, written.ptr, value).ec, std::errc::result_out_of_range);
+    ASSERT_EQ(value, max_value);
+    ASSERT_EQ(to_chars(buffer, buffer + 10, max_value).ec, std::errc::value_too_large);
+}
+
+TEST(CharConvTests, FromStringErrorTest) {
+    ASSERT_THROW(from_string(""), std::invalid_argument);
+    ASSERT_THROW(from_string("x12"), std::invalid_argument);
+    ASSERT_THROW(from_string("12x"), std::invalid_argument);
+    ASSERT_THROW(from_string("-1"), std::invalid_argument);
+    ASSERT_THROW(from_string(" 1"), std::invalid_argument);
+
+    std::string too_large(700, '9');
+    ASSERT_THROW(from_string(too_large.c_str()), std::out_of_range);
+    ASSERT_THROW(from_string("481560916771158684800786922703235625631274322714142263414417884163925873322306437689024231009526751394401758326916367106052034484602375642882110959089521812209947069992139877256008949136579813164413834190131240610432508865633901300457687591589632190325582710683886781973951695733384278544896131740867054246692573031629150247882082682647773168904426336814855367810693467547461780797071163567159452928068892906992787178135839959347223507647240845924670958716173279750751341651541295792537288393481542519773223140547524361834615428274169543954961376881442030303829940191406452725012875774576546969913778507874304"), std::out_of_range);
+    std::string wide(608, '0');
+    wide[0] = '1';
+    ASSERT_EQ(from_string(wide.c_str()), pow(10_u2022, 607_u2022));
+    ASSERT_THROW(from_string<uint256_t>("115792089237316195423570985008687907853269984665640564039457584007913129639936"),
+                 std::out_of_range);
+    ASSERT_EQ(from_string<uint256_t>("115792089237316195423570985008687907853269984665640564039457584007913129639935"),
+              ~from_uint<uint256_t>(0));
+}
+
+TEST(ConstexprTests, LiteralTest) {
+    constexpr uint2022_t a = 405272312330606683982498447530407677486444946329741974138101544027695953739965_u2022;
+    constexpr uint2022_t b = 3626777458843887524118528_u2022;
+    constexpr uint2022_t product = a * b;
+
+    static_assert(product == 1469832487054184013178321496623041557517329857560238757278117847507488415462666081345922349701550571520_u2022);
+    static_assert(product / b == a);
+    static_assert((product + from_uint(7)) % b == from_uint(7));
+    static_assert(product - a * b == 0_u2022);
+    static_assert(123'456'789_u2022 == from_uint(123456789));
+    static_assert(from_string("123456789") == 123456789_u2022);
+    static_assert((1_u2022 << 100) - 1_u2022 == 1267650600228229401496703205375_u2022);
+    static_assert(powmod(7_u2022, 560_u2022, 561_u2022) == 1_u2022);
+
+    constexpr uint4096_t wide = (from_uint<uint4096_t>(1) << 2040) - from_uint<uint4096_t>(1);
+    static_assert(wide * wide / wide == wide);
+
+    ASSERT_EQ(a, from_string("405272312330606683982498447530407677486444946329741974138101544027695953739965"));
+    ASSERT_EQ(product, a * b);
+}
+
+TEST(InPlaceTests, IncrementDecrementTest) {
+    uint2022_t value = from_string("18446744073709551615");
+
+    ASSERT_EQ(++value, from_string("18446744073709551616"));
+    ASSERT_EQ(value--, from_string("18446744073709551616"));
+    ASSERT_EQ(value, from_string("18446744073709551615"));
+    ASSERT_EQ(value++, from_string("18446744073709551615"));
+    ASSERT_EQ(--value, from_string("18446744073709551615"));
+
+    uint2022_t zero = from_uint(0);
+    --zero;
+    ++zero;
+    ASSERT_EQ(zero, from_uint(0));
+}
+
+TEST(InPlaceTests, DivModAssignTest) {
+    uint2022_t value = from_string("1469832487054184013178321496623041557517329857560238757278117847507488415462666081345922349701550571527");
+    uint2022_t remainder = value;
+
+    value /= from_string("3626777458843887524118528");
+    remainder %= from_string("3626777458843887524118528");
+
+    ASSERT_EQ(value, from_string("405272312330606683982498447530407677486444946329741974138101544027695953739965"));
+    ASSERT_EQ(remainder, from_uint(7));
+}
+
+TEST(InPlaceTests, FusedMultiplyAddTest) {
+    uint2022_t accumulator = from_string("340282366920938463463374607431768211455");
+    uint2022_t value = from_string("340282366920938463463374607431768211455");
+
+    fused_multiply_add(accumulator, value, 18446744073709551615ULL);
+    ASSERT_EQ(accumulator, from_string("6277101735386680763835789423207666416083908700390324961280"));
+
+    fused_multiply_add(accumulator, value, 0);
+    ASSERT_EQ(accumulator, from_string("6277101735386680763835789423207666416083908700390324961280"));
+}
+
+TEST(GenericWidthTests, Uint256Test) {
+    uint256_t a = from_string<uint256_t>("57896044618658097711785492504343953927996121800504035873582290433683637678137");
+    uint256_t b = from_string<uint256_t>("340282366920938463463374607431768211453");
+
+    ASSERT_EQ(a + b, from_string<uint256_t>("57896044618658097711785492504343953928336404167424974337045665041115405889590"));
+    ASSERT_EQ(a - b, from_string<uint256_t>("57896044618658097711785492504343953927655839433583097410118915826251869466684"));
+    ASSERT_EQ(a * b, from_string<uint256_t>("57896044618658097711785492504343958123337423568754351913527825459953916669781"));
+    ASSERT_EQ(a / b, from_string<uint256_t>("170141183460469231731687303715884105733"));
+    ASSERT_EQ(a % b, from_string<uint256_t>("170141183460469231731687303715884118088"));
+    ASSERT_EQ(b - a + a, b);
+}
+
+TEST(GenericWidthTests, Uint512Test) {
+    uint512_t a = from_string<uint512_t>("405272312330606683982498447530407677486444946329741974138101544027695953739965");
+    uint512_t b = from_string<uint512_t>("3626777458843887524118528");
+
+    std::stringstream stream;
+    stream << a * b;
+
+    ASSERT_EQ(stream.str(), "1469832487054184013178321496623041557517329857560238757278117847507488415462666081345922349701550571520");
+    ASSERT_EQ(a * b / b, a);
+    ASSERT_EQ(from_uint<uint512_t>(0), uint512_t());
+}
+
+TEST(GenericWidthTests, Uint4096Test) {
+    uint4096_t a = from_string<uint4096_t>("1");
+    uint4096_t b = from_string<uint4096_t>("3");
+    for (int i = 0; i < 2040; i++) {
+        a += a;
+    }
+    for (int i = 0; i < 1287; i++) {
+        b *= from_uint<uint4096_t>(3);
+    }
+    a += b;
+
+    std::pair<uint4096_t, uint4096_t> result = divmod(a, b);
+
+    ASSERT_EQ(result.first * b + result.second, a);
+    ASSERT_LT(result.second, b);
+    ASSERT_EQ(a * b / a, b);
+    ASSERT_EQ(a * b / b, a);
+}
+
+TEST(KaratsubaTests, Uint2022WidthTest) {
+    uint2022_t a = pow(3_u2022, 1270_u2022);
+    uint2022_t b = pow(7_u2022, 720_u2022);
+    ASSERT_EQ(a.significant_size(), uint2022_t::MAX_SIZE);
+    ASSERT_EQ(b.significant_size(), uint2022_t::MAX_SIZE);
+
+    uint64_t karatsuba[2 * uint2022_t::MAX_SIZE];
+    uint64_t schoolbook[2 * uint2022_t::MAX_SIZE] = {};
+    uint_detail::multiply_karatsuba<uint2022_t::MAX_SIZE>(a.digits, b.digits, uint2022_t::MAX_SIZE, karatsuba);
+    uint_detail::multiply_schoolbook(a.digits, uint2022_t::MAX_SIZE, b.digits, uint2022_t::MAX_SIZE, schoolbook,
+                                     2 * uint2022_t::MAX_SIZE);
+    for (size_t i = 0; i < 2 * uint2022_t::MAX_SIZE; i++) {
+        ASSERT_EQ(karatsuba[i], schoolbook[i]) << "limb " << i;
+    }
+
+    ASSERT_EQ(mulmod(a, b, (1_u2022 << 2021) + 12345_u2022),
+              from_string("118028863878934915467262074770542877838539196796693803257109157498676695274930060783746752683626591626828369373139313772115054107535724362485197054966747836230635008345293070798427585917078024650302979530155702573246593844185517349622799951036845901938432076511869418002012104381946580412961636621128589213789145032899154290998725867472706232468321998971708069948075381929741729301474655162038900904156247758913780233668936982130569784683665805787715453576295273511462922237920398767273745056686891069274836991024618718215667774225541011318528849651967584661430541505494711132282385874095081691951244203210590"));
+}
+
+TEST(BitwiseTests, LogicTest) {
+    uint2022_t a = from_string("340282366920938463463374607431768211455");
+    uint2022_t b = from_string("18446744073709551616");
+
+    ASSERT_EQ(a & b, b);
+    ASSERT_EQ(a | b, a);
+    ASSERT_EQ(a ^ b, from_string("340282366920938463444927863358058659839"));
+    ASSERT_EQ(a & from_uint(0), from_uint(0));
+    ASSERT_EQ(~from_uint(0), (from_uint(1) << 2021) - from_uint(1) + (from_uint(1) << 2021));
+    ASSERT_EQ(bit_width(~from_uint(0)), 2022);
+    ASSERT_EQ(popcount(~from_uint(0)), 2022);
+    ASSERT_EQ(~~a, a);
+    ASSERT_EQ(~~from_uint(0), from_uint(0));
+    ASSERT_EQ(~from_uint<uint256_t>(0) + from_uint<uint256_t>(1), from_uint<uint256_t>(0));
+}
+
+TEST(BitwiseTests, ShiftTest) {
+    uint2022_t one = from_uint(1);
+
+    ASSERT_EQ(one << 64, from_string("18446744073709551616"));
+    ASSERT_EQ(one << 127, from_string("170141183460469231731687303715884105728"));
+    ASSERT_EQ((one << 127) >> 63, from_string("18446744073709551616"));
+    ASSERT_EQ(from_uint(3) << 2020, (one << 2021) + (one << 2020));
+    ASSERT_EQ(from_uint(3) << 2021, one << 2021);
+    ASSERT_EQ(bit_width(one << 2021), 2022);
+    ASSERT_EQ(one << 2022, from_uint(0));
+    ASSERT_EQ(one << 2047, from_uint(0));
+    ASSERT_EQ(one << 2048, from_uint(0));
+    ASSERT_EQ(from_uint(12345) >> 14, from_uint(0));
+
+    uint2022_t value = from_string("1469832487054184013178321496623041557517329857560238757278117847507488415462666081345922349701550571520");
+    uint2022_t shifted = value;
+    shifted <<= 100;
+    shifted >>= 100;
+    ASSERT_EQ(shifted, value);
+    ASSERT_EQ(value >> 5, value / from_uint(32));
+}
+
+TEST(BitwiseTests, CountTest) {
+    uint2022_t value = from_string("340282366920938463463374607431768211455");
+
+    ASSERT_EQ(popcount(value), 128);
+    ASSERT_EQ(bit_width(value), 128);
+    ASSERT_EQ(countl_zero(value), 2022 - 128);
+    ASSERT_EQ(countl_zero(from_uint(1)), 2021);
+    ASSERT_EQ(countl_zero(from_uint(1) << 2021), 0);
+    ASSERT_EQ(countl_zero(~from_uint(0)), 0);
+    ASSERT_EQ(countl_zero(from_uint<uint256_t>(1)), 255);
+    ASSERT_EQ(bit_width(from_uint(0)), 0);
+    ASSERT_EQ(countl_zero(from_uint(0)), 2022);
+    ASSERT_EQ(bit_width(from_uint(1) << 2000), 2001);
+    ASSERT_EQ(countr_zero(value << 77), 77);
+    ASSERT_EQ(countr_zero(from_uint(0)), 2022);
+}
+
+TEST(BitwiseTests, WrapTest) {
+    uint2022_t max_value = ~0_u2022;
+
+    ASSERT_EQ(max_value + 1_u2022, 0_u2022);
+    ASSERT_EQ(0_u2022 - 1_u2022, max_value);
+    uint2022_t value = max_value;
+    ASSERT_EQ(++value, 0_u2022);
+    ASSERT_EQ(--value, max_value);
+    ASSERT_EQ((1_u2022 << 2021) * 2_u2022, 0_u2022);
+    ASSERT_EQ(max_value * max_value, 1_u2022);
+    ASSERT_EQ(pow(2_u2022, 2030_u2022), 0_u2022);
+    ASSERT_EQ(countl_zero(pow(2_u2022, 2030_u2022)), 2022);
+    ASSERT_EQ(pow(6_u2022, 800_u2022), from_string("253168737389359460681300277315883526789489248474667069002671036258801100432897787982655961209213765545007900824929339153018015330253085801350461170660368865302816532084157565345763890223261697996006271453877833222456527093413384044329507345216371784116801904600503985709746758718186154893498146629144256067152019701860597389178608295264837213356027997554363475891699501416385710737455059211028842825998322954597812198160885732276930425777731810520196069034700255282709664669379278985781445180905167119206779352397791139085279083593412881035634204354110148372048355122616249157901055366219617629631781021941760"));
+    ASSERT_LE(bit_width(pow(3_u2022, 1300_u2022)), 2022);
+    ASSERT_EQ(countl_zero(pow(3_u2022, 1300_u2022)), 2022 - bit_width(pow(3_u2022, 1300_u2022)));
+
+    uint2022_t product = pow(3_u2022, 700_u2022) * pow(5_u2022, 500_u2022);
+    ASSERT_EQ(bit_width(product), 2015);
+    ASSERT_EQ((product >> 8) << 8, product - (product & 255_u2022));
+    ASSERT_EQ((product << 7) >> 7, product & (max_value >> 7));
+    ASSERT_EQ(((product >> 100) << 100) + (product & ((1_u2022 << 100) - 1_u2022)), product);
+}
+
+static uint2022_t power_of(uint32_t base, int exponent) {
+    uint2022_t result = from_uint(1);
+    for (int i = 0; i < exponent; i++) {
+        result *= from_uint(base);
+    }
+    return result;
+}
+
+TEST(ModularTests, MulModTest) {
+    uint2022_t modulus = power_of(2, 1100) + from_uint(1);
+
+    ASSERT_EQ(mulmod(power_of(3, 500), power_of(7, 400), modulus),
+              from_string("2330762679925374669874490015118447650103246082688766714778394089222242167228224755933892580945141532393499862604007891229699502412313774481332490521739484760024806908412383031532982814063587787780985401372360162996529572275532758531061439807681630851750675118911105962625302209000670436094401059169407113368271074492504013331466322"));
+    ASSERT_EQ(mulmod(power_of(3, 500), power_of(7, 400), from_uint(1000)),
+              power_of(3, 500) * power_of(7, 400) % from_uint(1000));
+}
+
+TEST(ModularTests, PowModTest) {
+    uint2022_t odd_modulus = power_of(2, 1000) + from_uint(297);
+    uint2022_t exponent = power_of(2, 600) + from_uint(12345);
+
+    ASSERT_EQ(powmod(from_uint(7), exponent, odd_modulus),
+              from_string("1173481662468328272257412140967172794767384335362123806502871000120493438754740986045295441572204512371074622247577627832413667970638844112484351345618376166898607842183329802274359457342483924074943447060510410276561739183495411229776808148466647081919679613967490148607483701088613692343332337987695"));
+    ASSERT_EQ(powmod(power_of(3, 500), power_of(10, 150), power_of(10, 300)),
+              from_string("638602615289925936943221612624992520357501794606045811372525407782150498083441558363583009133561745009911556424288246719657425346640040422139327610000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000001"));
+    ASSERT_EQ(powmod(from_uint(5), from_uint(0), odd_modulus), from_uint(1));
+    ASSERT_EQ(powmod(from_uint(5), from_uint(3), from_uint(1)), from_uint(0));
+}
+
+TEST(ModularTests, MontgomeryContextTest) {
+    uint2022_t modulus = power_of(2, 1000) + from_uint(297);
+    montgomery_context<2022> context(modulus);
+    uint2022_t base = power_of(3, 500);
+
+    ASSERT_EQ(context.from_montgomery(context.to_montgomery(base)), base % modulus);
+    ASSERT_EQ(context.from_montgomery(context.multiply(context.to_montgomery(base), context.one())), base % modulus);
+    ASSERT_EQ(context.power(base, power_of(2, 600) + from_uint(12345)),
+              from_string("906045569399920984180448913321086038955302906683901429770910208550067305093940144554000677539371927913819887331789312351366288576211482120425767180749534100939788280002598236799805058312956981039607443698378786557855004479109628136657781155315601167810341974193531097544753928638529883605974727493404"));
+    ASSERT_EQ(context.power(from_uint(7), power_of(2, 600) + from_uint(12345)),
+              from_string("1173481662468328272257412140967172794767384335362123806502871000120493438754740986045295441572204512371074622247577627832413667970638844112484351345618376166898607842183329802274359457342483924074943447060510410276561739183495411229776808148466647081919679613967490148607483701088613692343332337987695"));
+}
+
+TEST(ModularTests, FullWidthModulusTest) {
+    uint2022_t modulus = (1_u2022 << 2021) + 12345_u2022;
+    ASSERT_EQ(modulus.significant_size(), uint2022_t::MAX_SIZE);
+    montgomery_context<2022> context(modulus);
+    uint2022_t base = pow(7_u2022, 700_u2022);
+
+    ASSERT_EQ(powmod(3_u2022, 65537_u2022, modulus),
+              from_string("196118127607854125854321035853460266750013880754277421413647313599094590905895727259140415551218685851433899147089873785257127900863721140966615281661078339677452061539606603696452533065150087522744425097605307924301641931927728240304298281827393466695607515178468588816603203106107779360938837735223034399536252391514972669060089272054129181011927769767399563311999299349020938272617777484210520339181375298140398583947570191315231982007269773339472226014755101374186622778252565817489569479340066278153011133886072377683329395178735171168672624961397105021078564096633478303254965818735943846223912499889076"));
+    ASSERT_EQ(context.from_montgomery(context.to_montgomery(base)), base);
+    ASSERT_EQ(context.from_montgomery(context.one()), 1_u2022);
+    ASSERT_EQ(context.power(base, (1_u2022 << 1500) + 99_u2022),
+              from_string("177585942975705149354803770151488685132568984198053539834439986151889588066575287069565656626885705683109524831134485558476250594642430523597776855804892262548232626911811492371186840216344981885292074350193907099316711499630520054620018370172558195226727383147096613733548040026011553540247067871369829277730505740823320786719382327586203043456977831472893738388995909476488100863062604252764118152380400004257508201081624541172247560832872106586923647999590898842017763086748680735172378052121137505352359686246267622296729204543446705974522698182535815365555252377384430401717216728229731315509172107602369"));
+
+    uint256_t prime = ~from_uint<uint256_t>(0) - from_uint<uint256_t>(188);
+    uint256_t inverse = powmod(from_uint<uint256_t>(3), prime - from_uint<uint256_t>(2), prime);
+    ASSERT_EQ(inverse, from_string<uint256_t>("77194726158210796949047323339125271902179989777093709359638389338608753093165"));
+    ASSERT_EQ(mulmod(inverse, from_uint<uint256_t>(3), prime), from_uint<uint256_t>(1));
+    montgomery_context<256, false> prime_context(prime);
+    ASSERT_EQ(prime_context.power((from_uint<uint256_t>(1) << 255) + from_uint<uint256_t>(7),
+                                  (from_uint<uint256_t>(1) << 200) + from_uint<uint256_t>(3)),
+              from_string<uint256_t>("48864492333401111313309873984769879508927002252377927507472164288744918982291"));
+}
+
+TEST(NumberTheoryTests, GcdLcmTest) {
+    uint2022_t a = (1_u2022 << 200) * pow(3_u2022, 100_u2022) * pow(7_u2022, 50_u2022);
+    uint2022_t b = (1_u2022 << 150) * pow(3_u2022, 120_u2022) * pow(11_u2022, 40_u2022);
+
+    ASSERT_EQ(gcd(a, b), from_string("735571377337281175975722145883189726959126286102281287306149927565761465446777498866888474624"));
+    ASSERT_EQ(lcm(a, b), from_string("2350493779592100532279033123894144779973210276895788712101172927635593857522777654601933473325858265386309952349169181710777193509531168941051790413115860102347986237719081129863944284466092077769293824"));
+    ASSERT_EQ(gcd(a, 0_u2022), a);
+    ASSERT_EQ(gcd(0_u2022, b), b);
+    ASSERT_EQ(gcd(a, 1_u2022), 1_u2022);
+    ASSERT_EQ(lcm(a, 0_u2022), 0_u2022);
+    ASSERT_EQ(gcd(pow(2_u2022, 2000_u2022) + 1_u2022, 3_u2022), 1_u2022);
+
+    uint2022_t wrapped = pow(6_u2022, 800_u2022);
+    ASSERT_EQ(gcd(wrapped, wrapped), wrapped);
+    ASSERT_EQ(gcd(wrapped, 1_u2022 << 2021), 1_u2022 << countr_zero(wrapped));
+    ASSERT_EQ(gcd(pow(2_u2022, 2030_u2022), 6_u2022), 6_u2022);
+}
+
+TEST(NumberTheoryTests, IsqrtTest) {
+    uint2022_t root = pow(3_u2022, 600_u2022);
+
+    ASSERT_EQ(isqrt(root * root), root);
+    ASSERT_EQ(isqrt(root * root - 1_u2022), root - 1_u2022);
+    ASSERT_EQ(isqrt(root * root + root + root), root);
+    ASSERT_EQ(isqrt(0_u2022), 0_u2022);
+    ASSERT_EQ(isqrt(3_u2022), 1_u2022);
+    ASSERT_EQ(isqrt(~0_u2022), (1_u2022 << 1011) - 1_u2022);
+}
+
+TEST(NumberTheoryTests, PowTest) {
+    ASSERT_EQ(pow(3_u2022, 1200_u2022), from_string("351160503938693614343626853747071562171016188034295260095490111881784318374960146045355120758560422119505624375491533176393589903573845466689382216842197981277867514717013259791763929689440964343969395781792087124646063583944648684169111729145300510135702655848244592583122673432949987979858826614906829469635537237525614665196540272658828569629679791428934101079072719564710584542576589075082850692588439679596816834818341802539921621995225917260921044846812391894365530686773081140839348912145464664288336497209664739248364322768319800659209785240272285297767697234264001"));
+    ASSERT_EQ(pow(12345_u2022, 0_u2022), 1_u2022);
+    ASSERT_EQ(pow(0_u2022, 5_u2022), 0_u2022);
+    ASSERT_EQ(pow(2_u2022, 2048_u2022), 0_u2022);
+    static_assert(pow(10_u2022, 30_u2022) == 1000000000000000000000000000000_u2022);
+}
+
+TEST(BatchTests, AddMulCompareTest) {
+    const size_t count = 1027;
+    uint_batch<2022> lhs(count);
+    uint_batch<2022> rhs(count);
+    std::vector<uint2022_t> lhs_values(count);
+    std::vector<uint2022_t> rhs_values(count);
+    uint2022_t seed = from_string("405272312330606683982498447530407677486444946329741970511324085183808429621437");
+    for (size_t k = 0; k < count; k++) {
+        seed *= seed;
+        seed += from_uint(k);
+        lhs_values[k] = (k % 5 == 0) ? seed - from_uint(1) - seed : seed;
+        rhs_values[k] = (k % 7 == 0) ? lhs_values[k] : seed * from_uint(k) + from_uint(3);
+        lhs.set(k, lhs_values[k]);
+        rhs.set(k, rhs_values[k]);
+    }
+
+    std::vector<int8_t> order(count);
+    compare_n(order.data(), lhs, rhs);
+    for (size_t k = 0; k < count; k++) {
+        int8_t expected = (lhs_values[k] < rhs_values[k]) ? -1 : (lhs_values[k] > rhs_values[k] ? 1 : 0);
+        ASSERT_EQ(order[k], expected) << k;
+    }
+
+    uint_batch<2022> sum(count);
+    add_n(sum, lhs, rhs);
+    mul_small_n(lhs, lhs, 4294967295u);
+    for (size_t k = 0; k < count; k++) {
+        ASSERT_EQ(sum.get(k), lhs_values[k] + rhs_values[k]) << k;
+        ASSERT_EQ(lhs.get(k), lhs_values[k] * from_uint(4294967295u)) << k;
+    }
+}
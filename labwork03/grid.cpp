@@ -0,0 +1,57 @@
+#include "grid.h"
+#include <algorithm>
+
+const size_t kMinPadding = 8;
+
+void Reallocate(Grid& grid, size_t padding_rows, size_t padding_columns) {
+    Grid result;
+    result.height = grid.height;
+    result.width = grid.width;
+    result.top = padding_rows;
+    result.left = padding_columns;
+    result.rows = grid.height + 2 * padding_rows;
+    result.stride = grid.width + 2 * padding_columns;
+    result.cells.assign(result.rows * result.stride, 0);
+
+    if (!grid.cells.empty()) {
+        for (size_t i = 0; i < grid.height; i++) {
+            std::copy(grid.Row(i), grid.Row(i) + grid.width, result.Row(i));
+        }
+    }
+    grid = std::move(result);
+}
+
+void ResizeGrid(Grid& grid, size_t height, size_t width) {
+    grid = Grid();
+    grid.height = height;
+    grid.width = width;
+    Reallocate(grid, kMinPadding, kMinPadding);
+}
+
+bool ReserveBorder(Grid& grid, size_t margin) {
+    size_t bottom = grid.rows - grid.top - grid.height;
+    size_t right = grid.stride - grid.left - grid.width;
+    if ((std::min(grid.top, bottom) >= margin) && (std::min(grid.left, right) >= margin)) {
+        return false;
+    }
+    Reallocate(grid, std::max({margin, kMinPadding, grid.height / 2}), std::max({margin, kMinPadding, grid.width / 2}));
+    return true;
+}
+
+void AddUpperLine(Grid& grid) {
+    grid.top--;
+    grid.height++;
+}
+
+void AddLowerLine(Grid& grid) {
+    grid.height++;
+}
+
+void AddLeftColumn(Grid& grid) {
+    grid.left--;
+    grid.width++;
+}
+
+void AddRightColumn(Grid& grid) {
+    grid.width++;
+}
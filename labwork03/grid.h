@@ -0,0 +1,45 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Sandpile cells in one contiguous buffer. The logical height x width area
+// sits inside zero padding of [top, left] cells; growing by a line moves the
+// view into the padding, and only running out of padding reallocates.
+struct Grid {
+    std::vector<uint64_t> cells;
+    size_t stride = 0;
+    size_t rows = 0;
+    size_t top = 0;
+    size_t left = 0;
+    size_t height = 0;
+    size_t width = 0;
+
+    uint64_t* Row(size_t i) {
+        return cells.data() + (top + i) * stride + left;
+    }
+
+    const uint64_t* Row(size_t i) const {
+        return cells.data() + (top + i) * stride + left;
+    }
+
+    uint64_t& At(size_t i, size_t j) {
+        return Row(i)[j];
+    }
+
+    uint64_t At(size_t i, size_t j) const {
+        return Row(i)[j];
+    }
+};
+
+void ResizeGrid(Grid& grid, size_t height, size_t width);
+
+bool ReserveBorder(Grid& grid, size_t margin);
+
+void AddUpperLine(Grid& grid);
+
+void AddLowerLine(Grid& grid);
+
+void AddLeftColumn(Grid& grid);
+
+void AddRightColumn(Grid& grid);
@@ -25,15 +25,15 @@ const uint64_t kColorBytes = 4;
 const uint64_t kColorPalleteSize = kColorBytes * kTotalColors;
 
 
-void ToImage(const std::deque<std::deque<uint64_t>>& matrix, const std::string& path) {
-    uint16_t width = matrix[0].size();
-    uint16_t height = matrix.size();
+void ToImage(const Grid& matrix, const std::string& path) {
+    int64_t width = matrix.width;
+    int64_t height = matrix.height;
 
     std::ofstream f;
     f.open(path, std::ios::out | std::ios::binary);
 
-    const uint64_t padding = (8 - (width % 8)) % 8;
-    const uint64_t full_width = width + padding;
+    const int64_t padding = (8 - (width % 8)) % 8;
+    const int64_t full_width = width + padding;
 
     const uint64_t fileSize = kFileHeaderSize + kInformationHeaderSize + kColorPalleteSize + (full_width * height) / 2;
     uint8_t fileHeader[kFileHeaderSize] = {};
@@ -123,11 +123,11 @@ void ToImage(const std::deque<std::deque<uint64_t>>& matrix, const std::string&
                 first_color = 0;
                 second_color = 0;
             } else if (y + 1 >= width) {
-                first_color = matrix[x][y];
+                first_color = matrix.At(x, y);
                 second_color = 0;
             } else {
-                first_color = matrix[x][y];
-                second_color = matrix[x][y + 1];
+                first_color = matrix.At(x, y);
+                second_color = matrix.At(x, y + 1);
             }
 
             if (first_color >= 4) {
@@ -1,5 +1,5 @@
-#include <deque>
+#include "grid.h"
 #include <string>
 #include <fstream>
 
-void ToImage(const std::deque<std::deque<uint64_t>>& matrix, const std::string& path);
\ No newline at end of file
+void ToImage(const Grid& matrix, const std::string& path);
\ No newline at end of file
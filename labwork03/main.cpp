@@ -2,16 +2,24 @@
 #include "parser.h"
 #include "sandpile.h"
 
-void SetOptions(std::deque<std::deque<uint64_t>>& sandpile, ConsoleParams options) {
+void SetOptions(Grid& sandpile, ConsoleParams options) {
     SetLengthWidth(sandpile, options.length, options.width);
     SetValues(sandpile, options.input);
 }
 
 int main(int argc, char* argv[]) {
     ConsoleParams options = ParseConsole(argc, argv);
-    std::deque<std::deque<uint64_t>> matrix;
+    if (options.threads == 0) {
+        std::cerr << "Number of threads must be from 1 to " << kMaxThreads << ".\n";
+        return 1;
+    }
+    Grid matrix;
     SetOptions(matrix, options);
-    SandCollapseCycle(matrix, options.max_iter, options.freq, options.output);
+    if (options.stable) {
+        SandCollapseStable(matrix, options.max_iter, options.freq, options.output, options.threads);
+    } else {
+        SandCollapseCycle(matrix, options.max_iter, options.freq, options.output, options.threads);
+    }
 
     return 0;
 }
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "parser.h"
+#include <cstdlib>
+#include <cstring>
 
 ConsoleParams ParseConsole(int argc, char* argv[]) {
     ConsoleParams options;
@@ -16,6 +18,13 @@ ConsoleParams ParseConsole(int argc, char* argv[]) {
                 options.max_iter = std::stoull(argv[++i]);
             } else if ((strcmp(argv[i], "-f") == 0) || (strcmp(argv[i], "--freq") == 0)) {
                 options.freq = std::stoull(argv[++i]);
+            } else if ((strcmp(argv[i], "-s") == 0) || (strcmp(argv[i], "--stable") == 0)) {
+                options.stable = true;
+            } else if ((strcmp(argv[i], "-t") == 0) || (strcmp(argv[i], "--threads") == 0)) {
+                char* end;
+                long long threads = std::strtoll(argv[++i], &end, 10);
+                bool isValid = (*end == '\0') && (threads >= 1) && (static_cast<uint64_t>(threads) <= kMaxThreads);
+                options.threads = isValid ? threads : 0;
             }
         }
     }
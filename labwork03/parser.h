@@ -10,6 +10,14 @@ struct ConsoleParams {
 
     uint64_t max_iter = 1;
     uint64_t freq = 1;
+
+    bool stable = false;
+    // 0 when -t is not a number from 1 to kMaxThreads.
+    uint64_t threads = 1;
 };
 
+// Bands need at least two rows each and a thread per core is all that helps,
+// so anything above this is a typo rather than a request.
+const uint64_t kMaxThreads = 256;
+
 ConsoleParams ParseConsole(int argc, char* argv[]);
\ No newline at end of file
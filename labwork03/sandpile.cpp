@@ -1,91 +1,396 @@
 #include "sandpile.h"
+#include "thread_pool.h"
+#include <algorithm>
+#include <atomic>
 
-void AddLeftColumn(std::deque<std::deque<uint64_t>>& sandpile) {
-    uint16_t height = sandpile.size();
+void SandMove(uint64_t* cell, size_t stride) {
+    *cell -= 4;
+    *(cell + stride) += 1;
+    *(cell + 1) += 1;
+    *(cell - stride) += 1;
+    *(cell - 1) += 1;
+}
+
+// Columns [begin, end) of every allocated row that a sweep has to look at;
+// begin >= end marks a row with nothing to do.
+struct DirtyRows {
+    std::vector<size_t> begin;
+    std::vector<size_t> end;
+};
+
+void ClearDirtyRows(DirtyRows& dirty, size_t rows) {
+    dirty.begin.assign(rows, SIZE_MAX);
+    dirty.end.assign(rows, 0);
+}
+
+void MarkDirty(DirtyRows& dirty, size_t row, size_t begin, size_t end) {
+    dirty.begin[row] = std::min(dirty.begin[row], begin);
+    dirty.end[row] = std::max(dirty.end[row], end);
+}
 
-    for (uint16_t i = 0; i < height; i++) {
-        sandpile[i].push_front(0);
+// What a sweep over some rows did: whether any cell toppled and which borders
+// of the logical area received grains.
+struct SweepResult {
+    bool toppled = false;
+    bool upperLine = false;
+    bool lowerLine = false;
+    bool leftColumn = false;
+    bool rightColumn = false;
+};
+
+void MergeSweepResult(SweepResult& total, const SweepResult& part) {
+    total.toppled |= part.toppled;
+    total.upperLine |= part.upperLine;
+    total.lowerLine |= part.lowerLine;
+    total.leftColumn |= part.leftColumn;
+    total.rightColumn |= part.rightColumn;
+}
+
+// Makes room for the next sweep and picks the cells it scans: everything after
+// the first call or a reallocation, otherwise what the last sweep marked.
+void PrepareSweep(Grid& sandpile, DirtyRows& current, DirtyRows& next) {
+    if (ReserveBorder(sandpile, 1) || next.begin.empty()) {
+        ClearDirtyRows(current, sandpile.rows);
+        for (size_t i = 0; i < sandpile.height; i++) {
+            MarkDirty(current, sandpile.top + i, sandpile.left, sandpile.left + sandpile.width);
+        }
+    } else {
+        std::swap(current, next);
     }
+    ClearDirtyRows(next, sandpile.rows);
 }
 
-void AddRightColumn(std::deque<std::deque<uint64_t>>& sandpile) {
-    uint16_t height = sandpile.size();
+// Topples every dirty cell of the allocated rows [first_row, end_row) floor(v / 4)
+// times. Writes reach one row above and below the range.
+SweepResult SweepRows(Grid& sandpile, const DirtyRows& current, DirtyRows& next, size_t first_row, size_t end_row) {
+    size_t stride = sandpile.stride;
+    size_t first_column = sandpile.left;
+    size_t end_column = sandpile.left + sandpile.width;
+    size_t top_row = sandpile.top;
+    size_t bottom_row = sandpile.top + sandpile.height - 1;
+    SweepResult result;
+
+    for (size_t i = first_row; i < end_row; i++) {
+        size_t begin = std::max(current.begin[i], first_column);
+        size_t end = std::min(current.end[i], end_column);
+        uint64_t* row = sandpile.cells.data() + i * stride;
+        for (size_t j = begin; j < end; j++) {
+            if (row[j] > 3) {
+                uint64_t topples = row[j] / 4;
+                row[j] -= topples * 4;
+                row[j + stride] += topples;
+                row[j + 1] += topples;
+                row[j - stride] += topples;
+                row[j - 1] += topples;
+                MarkDirty(next, i - 1, j, j + 1);
+                MarkDirty(next, i, j - 1, j + 2);
+                MarkDirty(next, i + 1, j, j + 1);
+                result.toppled = true;
+                result.upperLine |= (i == top_row);
+                result.lowerLine |= (i == bottom_row);
+                result.leftColumn |= (j == first_column);
+                result.rightColumn |= (j + 1 == end_column);
+            }
+        }
+    }
 
-    for (uint16_t i = 0; i < height; i++) {
-        sandpile[i].push_back(0);
+    return result;
+}
+
+void GrowBorders(Grid& sandpile, const SweepResult& result) {
+    if (result.upperLine) {
+        AddUpperLine(sandpile);
+    }
+    if (result.lowerLine) {
+        AddLowerLine(sandpile);
+    }
+    if (result.leftColumn) {
+        AddLeftColumn(sandpile);
+    }
+    if (result.rightColumn) {
+        AddRightColumn(sandpile);
     }
 }
 
-void AddUpperLine(std::deque<std::deque<uint64_t>>& sandpile) {
-    uint16_t width = sandpile[0].size();
+// Gauss-Seidel sweeps that topple each cell floor(v / 4) times per visit. By
+// the abelian property the stable state and the final grid size are the same
+// as after SandCollapse iterations, but a cell with v grains needs one visit
+// instead of v / 4 iterations. Each sweep only scans the columns next to the
+// cells that toppled in the previous one.
+void SandCollapseToStable(Grid& sandpile) {
+    DirtyRows current;
+    DirtyRows next;
+    SweepResult result;
+    result.toppled = true;
 
-    std::deque<uint64_t> line(width, 0);
-    sandpile.push_front(line);
+    while (result.toppled) {
+        PrepareSweep(sandpile, current, next);
+        result = SweepRows(sandpile, current, next, sandpile.top, sandpile.top + sandpile.height);
+        GrowBorders(sandpile, result);
+    }
 }
 
-void AddLowerLine(std::deque<std::deque<uint64_t>>& sandpile) {
-    uint16_t width = sandpile[0].size();
+// A band writes one row past each of its ends, so bands of the same colour are
+// independent as long as the band between them has at least two rows.
+const size_t kMinBandRows = 2;
+
+// More bands than threads lets idle threads pick up the busy middle of a pile.
+const size_t kBandsPerThread = 4;
+
+// Passes over the bands: even bands, odd bands, or every band.
+const size_t kEvenBands = 0;
+const size_t kOddBands = 1;
+const size_t kAllBands = 2;
 
-    std::deque<uint64_t> line(width, 0);
-    sandpile.push_back(line);
+// Horizontal bands of the allocated rows; band b covers the rows
+// [rows[b], rows[b + 1]). The inner boundaries split the logical rows evenly,
+// the outer bands reach into the padding, so the split stays valid while the
+// grid grows until it is reallocated. Threads take bands one at a time.
+struct BandSchedule {
+    std::vector<size_t> rows;
+    std::atomic<size_t> taken[3];
+};
+
+void SplitBands(BandSchedule& bands, const Grid& sandpile, size_t threads) {
+    size_t count = 1;
+    if (threads > 1) {
+        count = std::max<size_t>(1, std::min(threads * kBandsPerThread, sandpile.height / kMinBandRows));
+    }
+    bands.rows.resize(count + 1);
+    for (size_t band = 1; band < count; band++) {
+        bands.rows[band] = sandpile.top + sandpile.height * band / count;
+    }
+    bands.rows[0] = 0;
+    bands.rows[count] = sandpile.rows;
 }
 
-void SandMove(std::deque<std::deque<uint64_t>>& sandpile, uint16_t i, uint16_t j, bool upperLine, bool leftColumn) {
-    sandpile[i + upperLine][j + leftColumn] -= 4;
-    sandpile[i + 1 + upperLine][j + leftColumn]++;
-    sandpile[i + upperLine][j + 1 + leftColumn]++;
-    sandpile[i - 1 + upperLine][j + leftColumn]++;
-    sandpile[i + upperLine][j - 1 + leftColumn]++;
+void ResetBands(BandSchedule& bands) {
+    for (std::atomic<size_t>& taken : bands.taken) {
+        taken = 0;
+    }
 }
 
-bool SandCollapse(std::deque<std::deque<uint64_t>>& sandpile, std::deque<std::deque<uint64_t>>& sandpile_copy) {
-    uint16_t width = sandpile[0].size();
-    uint16_t height = sandpile.size();
-    sandpile_copy = sandpile;
-    bool isCollapsePossible = false;
-    bool upperLine = false;
-    bool lowerLine = false;
-    bool leftColumn = false;
-    bool rightColumn = false;
+bool TakeBand(BandSchedule& bands, size_t pass, size_t& band) {
+    if (pass == kAllBands) {
+        band = bands.taken[pass]++;
+    } else {
+        band = 2 * bands.taken[pass]++ + pass;
+    }
+    return band + 1 < bands.rows.size();
+}
 
-    for (uint16_t i = 0; i < height; i++) {
-        for (uint16_t j = 0; j < width; j++) {
-            if (sandpile_copy[i][j] > 3) {
-                isCollapsePossible = true;
-                if ((i + 1 >= height) && !lowerLine) {
-                    AddLowerLine(sandpile);
-                    lowerLine = true;
-                }
-                if ((i - 1 < 0) && !upperLine) {
-                    AddUpperLine(sandpile);
-                    upperLine = true;
-                }
-                if ((j + 1 >= width) && !rightColumn) {
-                    AddRightColumn(sandpile);
-                    rightColumn = true;
-                }
-                if ((j - 1 < 0) && !leftColumn) {
-                    AddLeftColumn(sandpile);
-                    leftColumn = true;
+// The same sweeps as SandCollapseToStable, with the even bands swept in
+// parallel and then the odd ones, so two threads never touch the same row at
+// once. The toppling order changes but the abelian property keeps the stable
+// state. Growing and reallocating the grid happens between sweeps.
+void SandCollapseToStable(Grid& sandpile, ThreadPool& pool) {
+    DirtyRows current;
+    DirtyRows next;
+    BandSchedule bands;
+    std::vector<SweepResult> results(pool.Size());
+    SweepResult total;
+    total.toppled = true;
+
+    while (total.toppled) {
+        PrepareSweep(sandpile, current, next);
+        SplitBands(bands, sandpile, pool.Size());
+        ResetBands(bands);
+        pool.Run([&](size_t thread) {
+            results[thread] = SweepResult();
+            size_t band;
+            while (TakeBand(bands, kEvenBands, band)) {
+                MergeSweepResult(results[thread], SweepRows(sandpile, current, next, bands.rows[band], bands.rows[band + 1]));
+            }
+            pool.Wait();
+            while (TakeBand(bands, kOddBands, band)) {
+                MergeSweepResult(results[thread], SweepRows(sandpile, current, next, bands.rows[band], bands.rows[band + 1]));
+            }
+        });
+
+        total = SweepResult();
+        for (const SweepResult& result : results) {
+            MergeSweepResult(total, result);
+        }
+        GrowBorders(sandpile, total);
+    }
+}
+
+// Once this share of the grid is unstable, rescanning it row by row is cheaper
+// than checking the neighbours of every toppled cell.
+const size_t kDenseWorklistRatio = 16;
+
+// The cells of one band, as offsets into Grid::cells: those that topple in
+// the current iteration and, of those, the ones in the band's first and last
+// row, whose neighbours across the edge belong to the next band over.
+struct BandCells {
+    std::vector<size_t> cells;
+    std::vector<size_t> next;
+    std::vector<size_t> firstRow;
+    std::vector<size_t> lastRow;
+};
+
+// Cells that are unstable at the start of an iteration, kept per band. A band
+// only reads and writes the queued marks of its own rows, which are all zero
+// between iterations. With one thread there is a single band.
+struct Worklist {
+    explicit Worklist(size_t threads)
+        : pool(threads),
+          results(pool.Size()) {
+    }
+
+    ThreadPool pool;
+    BandSchedule bands;
+    std::vector<BandCells> bandCells;
+    std::vector<uint8_t> queued;
+    std::vector<SweepResult> results;
+    bool isRescanNeeded = true;
+    std::atomic<bool> isCollapsePossible{false};
+};
+
+void QueueIfUnstable(const Grid& sandpile, Worklist& worklist, std::vector<size_t>& cells, size_t cell) {
+    if ((sandpile.cells[cell] > 3) && !worklist.queued[cell]) {
+        worklist.queued[cell] = 1;
+        cells.push_back(cell);
+    }
+}
+
+// Lists the cells of band b that are unstable now: a scan of its logical area
+// after a reallocation or a dense iteration, otherwise the cells that toppled
+// in the last iteration and their neighbours.
+void CollectBand(const Grid& sandpile, Worklist& worklist, size_t b) {
+    size_t stride = sandpile.stride;
+    size_t first_row = worklist.bands.rows[b];
+    size_t end_row = worklist.bands.rows[b + 1];
+    BandCells& band = worklist.bandCells[b];
+    band.next.clear();
+
+    if (worklist.isRescanNeeded) {
+        size_t scan_end = std::min(end_row, sandpile.top + sandpile.height);
+        for (size_t i = std::max(first_row, sandpile.top); i < scan_end; i++) {
+            size_t row_start = i * stride;
+            for (size_t j = sandpile.left; j < sandpile.left + sandpile.width; j++) {
+                if (sandpile.cells[row_start + j] > 3) {
+                    band.next.push_back(row_start + j);
                 }
-                SandMove(sandpile, i, j, upperLine, leftColumn);
             }
         }
+        return;
     }
 
-    return isCollapsePossible;
+    for (size_t cell : band.cells) {
+        QueueIfUnstable(sandpile, worklist, band.next, cell);
+        QueueIfUnstable(sandpile, worklist, band.next, cell + 1);
+        QueueIfUnstable(sandpile, worklist, band.next, cell - 1);
+        if (cell + stride < end_row * stride) {
+            QueueIfUnstable(sandpile, worklist, band.next, cell + stride);
+        }
+        if (cell >= (first_row + 1) * stride) {
+            QueueIfUnstable(sandpile, worklist, band.next, cell - stride);
+        }
+    }
+    if (b > 0) {
+        for (size_t cell : worklist.bandCells[b - 1].lastRow) {
+            QueueIfUnstable(sandpile, worklist, band.next, cell + stride);
+        }
+    }
+    if (b + 2 < worklist.bands.rows.size()) {
+        for (size_t cell : worklist.bandCells[b + 1].firstRow) {
+            QueueIfUnstable(sandpile, worklist, band.next, cell - stride);
+        }
+    }
+}
+
+// Topples the listed cells of band b once each and keeps them as the band's
+// cells for the next collection.
+void ToppleBand(Grid& sandpile, Worklist& worklist, size_t b, SweepResult& result) {
+    size_t stride = sandpile.stride;
+    size_t top_row = sandpile.top;
+    size_t bottom_row = sandpile.top + sandpile.height - 1;
+    size_t first_column = sandpile.left;
+    size_t last_column = sandpile.left + sandpile.width - 1;
+    size_t first_row_end = (worklist.bands.rows[b] + 1) * stride;
+    size_t last_row_start = (worklist.bands.rows[b + 1] - 1) * stride;
+    BandCells& band = worklist.bandCells[b];
+    band.cells.swap(band.next);
+    band.firstRow.clear();
+    band.lastRow.clear();
+
+    for (size_t cell : band.cells) {
+        size_t row = cell / stride;
+        size_t column = cell % stride;
+        result.toppled = true;
+        result.upperLine |= (row == top_row);
+        result.lowerLine |= (row == bottom_row);
+        result.leftColumn |= (column == first_column);
+        result.rightColumn |= (column == last_column);
+        SandMove(sandpile.cells.data() + cell, stride);
+        worklist.queued[cell] = 0;
+        if (cell < first_row_end) {
+            band.firstRow.push_back(cell);
+        }
+        if (cell >= last_row_start) {
+            band.lastRow.push_back(cell);
+        }
+    }
 }
 
-void SetLengthWidth(std::deque<std::deque<uint64_t>>& sandpile, uint16_t length, uint16_t width) {
-    std::deque<uint64_t> line;
-    line.resize(width);
+// One iteration: every cell that was unstable when the iteration started
+// topples once. Every band first lists its unstable cells while nothing is
+// written; then the even bands topple them in parallel, then the odd ones.
+bool SandCollapse(Grid& sandpile, Worklist& worklist) {
+    if (ReserveBorder(sandpile, 1) || worklist.bandCells.empty()) {
+        SplitBands(worklist.bands, sandpile, worklist.pool.Size());
+        worklist.bandCells.assign(worklist.bands.rows.size() - 1, BandCells());
+        worklist.queued.assign(sandpile.cells.size(), 0);
+        worklist.isRescanNeeded = true;
+    }
+    ResetBands(worklist.bands);
+    worklist.isCollapsePossible = false;
 
-    for (size_t i = 0; i < length; i++) {
-        sandpile.push_back(line);
+    worklist.pool.Run([&](size_t thread) {
+        BandSchedule& bands = worklist.bands;
+        size_t band;
+        while (TakeBand(bands, kAllBands, band)) {
+            CollectBand(sandpile, worklist, band);
+            if (!worklist.bandCells[band].next.empty()) {
+                worklist.isCollapsePossible = true;
+            }
+        }
+        worklist.pool.Wait();
+        if (!worklist.isCollapsePossible) {
+            return;
+        }
+        worklist.results[thread] = SweepResult();
+        while (TakeBand(bands, kEvenBands, band)) {
+            ToppleBand(sandpile, worklist, band, worklist.results[thread]);
+        }
+        worklist.pool.Wait();
+        while (TakeBand(bands, kOddBands, band)) {
+            ToppleBand(sandpile, worklist, band, worklist.results[thread]);
+        }
+    });
+    if (!worklist.isCollapsePossible) {
+        return false;
+    }
+
+    SweepResult total;
+    size_t toppled = 0;
+    for (const SweepResult& result : worklist.results) {
+        MergeSweepResult(total, result);
+    }
+    for (const BandCells& band : worklist.bandCells) {
+        toppled += band.cells.size();
     }
+    GrowBorders(sandpile, total);
+    worklist.isRescanNeeded = toppled * kDenseWorklistRatio >= sandpile.height * sandpile.width;
+    return true;
 }
 
-void SetValues(std::deque<std::deque<uint64_t>>& sandpile, const std::string& filename) {
+void SetLengthWidth(Grid& sandpile, uint16_t length, uint16_t width) {
+    ResizeGrid(sandpile, length, width);
+}
+
+void SetValues(Grid& sandpile, const std::string& filename) {
     std::ifstream file;
     file.open(filename);
     uint16_t x, y;
@@ -97,23 +402,22 @@ void SetValues(std::deque<std::deque<uint64_t>>& sandpile, const std::string& fi
             break;
         }
         file >> y >> value;
-        sandpile[x][y] = value;
+        sandpile.At(x, y) = value;
     }
 }
 
-void SandCollapseCycle(std::deque<std::deque<uint64_t>>& sandpile, uint64_t max_iter, uint64_t freq,
-                       const std::string& path) {
+void SandCollapseCycle(Grid& sandpile, uint64_t max_iter, uint64_t freq, const std::string& path, size_t threads) {
     uint64_t iter = 0;
     bool onlyLastCondition = freq == 0;
     std::string full_path = path + "\\";
     std::string ext = ".bmp";
-    std::deque<std::deque<uint64_t>> sandpile_copy = sandpile;
+    Worklist worklist(threads);
 
     if (!onlyLastCondition) {
         ToImage(sandpile, full_path + std::to_string(iter / freq) + ext);
     }
 
-    while ((iter < max_iter) && SandCollapse(sandpile, sandpile_copy)) {
+    while ((iter < max_iter) && SandCollapse(sandpile, worklist)) {
         iter++;
         if ((!onlyLastCondition) && (iter % freq == 0)) {
             ToImage(sandpile, full_path + std::to_string(iter / freq) + ext);
@@ -123,4 +427,35 @@ void SandCollapseCycle(std::deque<std::deque<uint64_t>>& sandpile, uint64_t max_
     if (onlyLastCondition) {
         ToImage(sandpile, full_path + "0" + ext);
     }
+}
+
+// Toppling floor(v / 4) at once can push a cell above anything the iterative
+// engine would hold, but never above the total number of grains. Only when that
+// total fits into uint64_t is the bulk mode safe from overflow.
+bool IsTotalGrainsRepresentable(const Grid& sandpile) {
+    uint64_t total = 0;
+    for (size_t i = 0; i < sandpile.height; i++) {
+        const uint64_t* row = sandpile.Row(i);
+        for (size_t j = 0; j < sandpile.width; j++) {
+            if (row[j] > UINT64_MAX - total) {
+                return false;
+            }
+            total += row[j];
+        }
+    }
+    return true;
+}
+
+void SandCollapseStable(Grid& sandpile, uint64_t max_iter, uint64_t freq, const std::string& path, size_t threads) {
+    if (!IsTotalGrainsRepresentable(sandpile)) {
+        SandCollapseCycle(sandpile, max_iter, freq, path, threads);
+        return;
+    }
+    if (threads > 1) {
+        ThreadPool pool(threads);
+        SandCollapseToStable(sandpile, pool);
+    } else {
+        SandCollapseToStable(sandpile);
+    }
+    ToImage(sandpile, path + "\\0.bmp");
 }
\ No newline at end of file
@@ -0,0 +1,40 @@
+# Runs SandPile once in the default mode and once with -s on the same input and
+# fails unless both write the same final image.
+#   SANDPILE, INPUT, LENGTH, WIDTH, ITERATIONS, THREADS, WORK_DIR
+
+if(WIN32)
+    set(image "out/0.bmp")
+else()
+    set(image "out\\0.bmp")
+endif()
+
+foreach(mode iterative stable)
+    file(REMOVE_RECURSE "${WORK_DIR}/${mode}")
+    file(MAKE_DIRECTORY "${WORK_DIR}/${mode}/out")
+endforeach()
+
+execute_process(
+    COMMAND "${SANDPILE}" -l ${LENGTH} -w ${WIDTH} -i "${INPUT}" -o out -m ${ITERATIONS} -f 0
+    WORKING_DIRECTORY "${WORK_DIR}/iterative"
+    RESULT_VARIABLE result
+)
+if(result)
+    message(FATAL_ERROR "default mode failed: ${result}")
+endif()
+
+execute_process(
+    COMMAND "${SANDPILE}" -l ${LENGTH} -w ${WIDTH} -i "${INPUT}" -o out -m ${ITERATIONS} -f 0 -s -t ${THREADS}
+    WORKING_DIRECTORY "${WORK_DIR}/stable"
+    RESULT_VARIABLE result
+)
+if(result)
+    message(FATAL_ERROR "stable mode failed: ${result}")
+endif()
+
+execute_process(
+    COMMAND "${CMAKE_COMMAND}" -E compare_files "${WORK_DIR}/iterative/${image}" "${WORK_DIR}/stable/${image}"
+    RESULT_VARIABLE different
+)
+if(different)
+    message(FATAL_ERROR "stable mode image differs from the default mode")
+endif()
@@ -0,0 +1,40 @@
+# Runs SandPile in the default mode on one thread and on THREADS threads with the
+# same input and fails unless every image written along the way is the same.
+#   SANDPILE, INPUT, LENGTH, WIDTH, ITERATIONS, FREQ, THREADS, WORK_DIR
+
+if(WIN32)
+    set(prefix "out/")
+else()
+    set(prefix "out\\")
+endif()
+
+foreach(threads 1 ${THREADS})
+    file(REMOVE_RECURSE "${WORK_DIR}/${threads}")
+    file(MAKE_DIRECTORY "${WORK_DIR}/${threads}/out")
+    execute_process(
+        COMMAND "${SANDPILE}" -l ${LENGTH} -w ${WIDTH} -i "${INPUT}" -o out -m ${ITERATIONS} -f ${FREQ} -t ${threads}
+        WORKING_DIRECTORY "${WORK_DIR}/${threads}"
+        RESULT_VARIABLE result
+    )
+    if(result)
+        message(FATAL_ERROR "${threads} threads failed: ${result}")
+    endif()
+    # GLOB turns the backslash of out\N.bmp into a slash, so only count the images.
+    file(GLOB written "${WORK_DIR}/${threads}/*.bmp" "${WORK_DIR}/${threads}/out/*.bmp")
+    list(LENGTH written images_${threads})
+endforeach()
+
+if(images_1 EQUAL 0 OR NOT images_1 EQUAL images_${THREADS})
+    message(FATAL_ERROR "${THREADS} threads wrote ${images_${THREADS}} images, one thread wrote ${images_1}")
+endif()
+
+math(EXPR last "${images_1} - 1")
+foreach(index RANGE ${last})
+    execute_process(
+        COMMAND "${CMAKE_COMMAND}" -E compare_files "${WORK_DIR}/1/${prefix}${index}.bmp" "${WORK_DIR}/${THREADS}/${prefix}${index}.bmp"
+        RESULT_VARIABLE different
+    )
+    if(different)
+        message(FATAL_ERROR "image ${index} differs between one and ${THREADS} threads")
+    endif()
+endforeach()
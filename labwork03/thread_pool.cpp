@@ -0,0 +1,72 @@
+#include "thread_pool.h"
+#include <algorithm>
+
+const size_t kBarrierSpins = 1 << 14;
+
+Barrier::Barrier(size_t threads)
+    : threads_(threads) {
+}
+
+void Barrier::Wait() {
+    if (threads_ == 1) {
+        return;
+    }
+    size_t generation = generation_.load(std::memory_order_acquire);
+    if (waiting_.fetch_add(1, std::memory_order_acq_rel) + 1 == threads_) {
+        waiting_.store(0, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            generation_.fetch_add(1, std::memory_order_release);
+        }
+        condition_.notify_all();
+        return;
+    }
+    for (size_t spin = 0; spin < kBarrierSpins; spin++) {
+        if (generation_.load(std::memory_order_acquire) != generation) {
+            return;
+        }
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this, generation] { return generation_.load(std::memory_order_acquire) != generation; });
+}
+
+ThreadPool::ThreadPool(size_t threads)
+    : barrier_(std::max<size_t>(threads, 1)) {
+    for (size_t thread = 1; thread < threads; thread++) {
+        workers_.emplace_back(&ThreadPool::Work, this, thread);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    stopped_ = true;
+    barrier_.Wait();
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::Size() const {
+    return workers_.size() + 1;
+}
+
+void ThreadPool::Run(const std::function<void(size_t)>& task) {
+    task_ = &task;
+    barrier_.Wait();
+    task(0);
+    barrier_.Wait();
+}
+
+void ThreadPool::Wait() {
+    barrier_.Wait();
+}
+
+void ThreadPool::Work(size_t thread) {
+    while (true) {
+        barrier_.Wait();
+        if (stopped_) {
+            return;
+        }
+        (*task_)(thread);
+        barrier_.Wait();
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Waiting threads spin for a short while before they sleep: iterations of a
+// pile are a few hundred microseconds, far shorter than a condition variable
+// wake-up, but on an oversubscribed machine spinning would steal the core.
+class Barrier {
+public:
+    explicit Barrier(size_t threads);
+
+    void Wait();
+
+private:
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    const size_t threads_;
+    std::atomic<size_t> waiting_{0};
+    std::atomic<size_t> generation_{0};
+};
+
+// Threads that live as long as the pool. Run hands the same task to all of
+// them, the calling thread included as thread 0, and returns once every
+// thread has finished it; tasks split themselves into phases with Wait.
+class ThreadPool {
+public:
+    explicit ThreadPool(size_t threads);
+
+    ~ThreadPool();
+
+    size_t Size() const;
+
+    void Run(const std::function<void(size_t)>& task);
+
+    void Wait();
+
+private:
+    void Work(size_t thread);
+
+    Barrier barrier_;
+    std::vector<std::thread> workers_;
+    const std::function<void(size_t)>* task_ = nullptr;
+    bool stopped_ = false;
+};